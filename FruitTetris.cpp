@@ -20,151 +20,98 @@ Modified in Sep 2014 by Honghua Li (honghual@sfu.ca).
  */
 
 #include "include/Angel.h"
-#include <set>
 #include <vector>
-#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
 #include "robot.h"
+#include "game.h"
+#include "replay.h"
+#include "vertexformat.h"
+#include "profiler.h"
+#include "offscreen.h"
+#include "text.h"
+#include "animation.h"
 
 using namespace std;
 
-// misc constants
-#define TILE_DROP_SPEED 200
-#define TILE_DROP_SPEED_FAST 20
-#define MAX_TILE_ORIENTATIONS 4
-#define BOARD_WIDTH 10
-#define BOARD_HEIGHT 20
-#define MAX_FRUIT_GROUP 3
-#define BOARD_POINTS 1200*6
-#define MAX_GRIP_TIME 5
+// The front end draws the standard board, so its arrays are sized at compile time
+const int BOARD_WIDTH = StandardBoardSize::width;
+const int BOARD_HEIGHT = StandardBoardSize::height;
+// one cube of 36 vertices per cell
+#define BOARD_POINTS (BOARD_WIDTH*BOARD_HEIGHT*36)
+// a face of the grid has a line along every column and row boundary; depth lines join the faces at every corner
+#define GRID_FACE_POINTS (2*(BOARD_WIDTH + 1 + BOARD_HEIGHT + 1))
+#define GRID_DEPTH_POINTS (2*(BOARD_WIDTH + 1)*(BOARD_HEIGHT + 1))
+#define GRID_POINTS (2*GRID_FACE_POINTS + GRID_DEPTH_POINTS)
+// packed board positions are multiples of a 64th of a cell (33 pixels), fine enough for cells falling a fraction
+// of a row at a time to move smoothly; half a cell, which every corner is at, is 32 of them
+#define BOARD_POSITION_UNIT (33.0/64)
+// clean cells allowed between two dirty runs of the board before they are uploaded separately
+#define BOARD_UPLOAD_GAP 2
+// alpha of the ghost of the current tile, relative to the tile
+#define GHOST_ALPHA 0.3
 
 // forward declarations
-int checkFullRow(const vec2 &p);
-void recursiveCheck(const vec2 &p, const vec2 &dir, vector<vec2> *h, vector<vec2> *v);
-void checkGroupedFruits(const vec2 &p);
-void tileDrop(int type);
-void rotateCurrentTile(int n);
-bool isInBoardBounds(vec2 p);
-bool isInBoardBounds(int x, int y);
 void updateTileColours();
-vec4 getCellColour(const vec2 &p);
-
-// information to draw to screen
-enum Text {
-	TextScore,
-	TextCells,
-	TextRows,
-	TextGG,
-	GripTime,
-	TextMax
+void cellCube(vec4 *cubepoints, float x, float y);
+
+// the game being drawn, created in main()
+GameState *game;
+// inputs of the game, written to recordFile on exit if -record is given
+Replay replay;
+const char *recordFile = NULL;
+
+// times the stages of display(), summarized in the HUD when showProfile is set and written to profileFile on exit
+Profiler profiler;
+const char *profileFile = NULL;
+bool showProfile = false;
+// HUD lines of the profile, rebuilt every PROFILE_HUD_FRAMES frames
+#define PROFILE_HUD_FRAMES 30
+vector<string> profileLines;
+
+// Every piece of HUD text has its own slot in the text renderer
+enum HudText {
+	HudTilePosition,
+	HudFun,
+	HudScore,
+	HudGripTime,
+	HudGameOver,
+	HudPlayAgain,
+	HudProfile, // first of the MaxProfileStages + 1 lines of the profile
+	MaxHudTexts = HudProfile + MaxProfileStages + 1
 };
-float gui[TextMax];
+TextRenderer text;
 
-enum TileInfo {
-	TILE_CREATE,
-	TILE_TICK,
-	TILE_TICK_FAST,
-	TILE_COLUMN_CHECK
-};
-bool tileFalling = false;
-// various callback variables to make sure only 1 callback is called at once
-int numCheckFruitColumnCallbacks = 0;
-int numDropTileCallbacks = 0;
-int numFastDropTileCallbacks = 0;
-// vector of removed cells to perform alpha modifications on
-vector<vec2> cellsToAnimate;
-// vector of removed cells to perform column drops on
-vector<vec2> removedCells;
-
-// vector sorting
-struct sortByDecY { bool operator() (vec2 const &L, vec2 const &R) { return L.y > R.y; } };
-struct sortByIncY { bool operator() (vec2 const &L, vec2 const &R) { return L.y < R.y; } };
-
-// Debug prints
-void printVec4(const vec4 &f) {
-	cout.precision(6);
-	cout << fixed << "Vec4: " << f.x << " " << f.y << " " <<f.z <<" "<<f.w << endl;
-}
-void printVec2(const vec2 &f) { cout << "(" << f.x << "," << f.y << ")"; }
-bool vec4Equal(const vec4 &a, const vec4 &b) {
-	return a.x==b.x && a.y==b.y && a.z==b.z && a.w==b.w;
-}
+// rendering into an FBO with no window
+bool offscreen = false;
+// the last offscreen frame is saved here if given
+const char *screenshotFile = NULL;
 
-int tileDropSpeed = TILE_DROP_SPEED;
-// current tile
-vec2 currTileOffset[4]; // An array of 4 2d vectors representing displacement from a 'center' piece of the tile, on the grid
-vec2 currTilePos = vec2(5, BOARD_HEIGHT - 1); // The position of the current tile using grid coordinates ((0,0) is the bottom left corner)
-int currTileShapeIndex = 0;
-vec4 currTileColours[4];
+// removed cells fading out and collapsed cells falling into place
+BoardAnimation animation;
+// the robot arm's buffers, posed from the game every frame
+robot::Model robotModel;
 
-//-------------------------------------------------------------------------------------------------------------------
-// TileShape enum of list of valid shapes
-enum TileShape {
-	TileShapeI,
-	TileShapeS,
-	TileShapeZ,
-	TileShapeO,
-	TileShapeT,
-	TileShapeJ,
-	TileShapeL,
-	MaxTileShapes
-};
-const vec2 allShapes[MaxTileShapes][4] =
-	{{vec2(-2,  0), vec2(-1,  0), vec2(0, 0), vec2( 1,  0)},  // I
-	 {vec2(-1, -1), vec2( 0, -1), vec2(0, 0), vec2( 1,  0)},  // S
-	 {vec2( 1, -1), vec2( 0, -1), vec2(0, 0), vec2(-1,  0)},  // Z
-	 {vec2(-1, -1), vec2( 0, -1), vec2(0, 0), vec2(-1,  0)},  // O
-	 {vec2(-1,  0), vec2( 1,  0), vec2(0, 0), vec2( 0,  1)},  // T
-	 {vec2(-1,  1), vec2(-1,  0), vec2(0, 0), vec2( 1,  0)},  // J
-	 {vec2(-1, -1), vec2(-1,  0), vec2(0, 0), vec2( 1,  0)}}; // L
 //-------------------------------------------------------------------------------------------------------------------
 const vec4 white          = vec4(1.0, 1.0, 1.0, 1.0);
 const vec4 grey           = vec4(0.6, 0.6, 0.6, 1.0);
 const vec4 gridColour     = vec4(0.8, 0.8, 0.8, 0.8);
 const vec4 black          = vec4(0.0, 0.0, 0.0, 1.0);
-const vec4 cellFreeColour = vec4(1.0, 1.0, 1.0, 0.0);
-// fruit colors: https://kuler.adobe.com/create/color-wheel/?base=2&rule=Custom&selected=3&name=My%20Kuler%20Theme&mode=rgb&rgbvalues=1,0.8626810137791381,0,0.91,0.5056414909356977,0,1,0.10293904996979109,0,0.5587993310653088,0,0.91,0.1658698853207745,1,0.10159077034733333&swatchOrder=0,1,2,3,4
-const vec4 grape  = vec4(142/255.0 ,  54/255.0 , 232/255.0 , 1.0);
-const vec4 apple  = vec4(255/255.0 ,  26/255.0 ,   0/255.0 , 1.0);
-const vec4 banana = vec4(255/255.0 , 220/255.0 ,   0/255.0 , 1.0);
-const vec4 pear   = vec4( 42/255.0 , 255/255.0 ,  26/255.0 , 1.0);
-const vec4 orange = vec4(232/255.0 , 129/255.0 ,   0/255.0 , 1.0);
-enum FruitColours {
-	ColourGrape,
-	ColourApple,
-	ColourBanana,
-	ColourPear,
-	ColourOrange,
-	MaxFruitColours
-};
-const vec4 fruitColours[MaxFruitColours] = {grape, apple, banana, pear, orange};
 //-------------------------------------------------------------------------------------------------------------------
  
-//board[x][y] represents whether the cell (x,y) is occupied
-bool board[BOARD_WIDTH][BOARD_HEIGHT]; 
-
-void setCellOccupied(const vec2 &p, bool o) {
-	board[(int)p.x][(int)p.y] = o;
-}
-void setCellOccupied(int x, int y, bool o) {
-	board[x][y] = o;
-}
-bool isCellOccupied(int x, int y) {
-	if(!isInBoardBounds(x, y))
-		return false;
-	return board[x][y];
-}
-bool isCellOccupied(const vec2 &p) {
-	if(!isInBoardBounds(p))
-		return false;
-	return board[(int)p.x][(int)p.y];
-}
-
-//An array containing the colour of each of the 10*20*2*3 vertices that make up the board
-//Initially, all will be set to black. As tiles are placed, sets of 6 vertices (2 triangles; 1 square)
-//will be set to the appropriate colour in this array before updating the corresponding VBO
+//An array containing the colour of each of the BOARD_WIDTH*BOARD_HEIGHT*6*6 vertices that make up the board
+//Sets of 36 vertices (12 triangles; 1 cube) are set to the colour of their game cell in updateBoard()
 vec4 boardcolours[BOARD_POINTS];
+// With instancing the board is one unit cube drawn per cell instead, and each cell only needs its colour as RGBA8
+bool instancedBoard;
+GLubyte boardcellcolours[BOARD_WIDTH*BOARD_HEIGHT][4];
+// cells whose vertices in boardcolours are out of date, on top of the ones the game reports
+Bitboard boardDirty;
+// fadeOut the board colours were last computed with
+float boardFadeOut = 1.0f;
 
 // xsize and ysize represent the window size - updated if window is reshaped to prevent stretching of the game
 int xsize = 400; 
@@ -173,12 +120,25 @@ int ysize = 720;
 // alpha value for fade out animation upon game over
 float fadeOut = 1.0f;
 
+// shader program for everything but the instanced board
+GLuint program;
+
 // location of vertex attributes in the shader program
 GLuint vPosition;
 GLuint vColor;
 
 // locations of uniform variables in shader program
 GLuint locMVP;
+GLint locPositionUnit;
+
+// shader program of the instanced board, and the locations of its attributes and uniforms
+GLuint boardProgram;
+GLuint boardPosition, boardCell, boardColour, boardDrop;
+GLuint locBoardMVP;
+
+// with instancing the robot is drawn by its own program too, one instance per part
+bool instancedRobot;
+GLuint robotProgram;
 
 void setMVP(mat4 &mvp) {
 	glUniformMatrix4fv(locMVP, 1, GL_TRUE, mvp);
@@ -199,6 +159,8 @@ enum VBO_IDs {
 	GridColourBO,
 	BoardPositionBO,
 	BoardColourBO,
+	BoardCellBO,
+	BoardDropBO,
 	CurrentTilePositionBO,
 	CurrentTileColourBO,
 	MaxVboIds
@@ -206,182 +168,92 @@ enum VBO_IDs {
 GLuint vboIDs[MaxVboIds]; // Two Vertex Buffer Objects for each VAO (specifying vertex positions and colours, respectively)
 
 //-------------------------------------------------------------------------------------------------------------------
-bool isAboveBoard(vec2 p) {
-	if(p.x < 0 || p.x > BOARD_WIDTH - 1) return false;
-	if(p.y < 0) return false;
-	return true;
-}
-bool isInBoardBounds(vec2 p) {
-	if(p.x < 0 || p.x > BOARD_WIDTH - 1) return false;
-	if(p.y < 0 || p.y > BOARD_HEIGHT - 1) return false;
-	return true;
-}
-bool isInBoardBounds(int x, int y) {
-	return isInBoardBounds(vec2(x, y));
-}
-int canRelease() {
-	int cellsInBoard = 0; int cellsOccupied = 0;
-	for(int i = 0; i < 4; i++) {
-		vec2 p = currTilePos + currTileOffset[i];
-		if(isCellOccupied(p)) cellsOccupied++;
-		if(isAboveBoard(p)) cellsInBoard++;
-	}
-	return cellsInBoard == 4 && cellsOccupied == 0;
+
+// row the ghost of the current tile is drawn on, where the tile lands if dropped; -1 while there is no ghost
+int ghostRowShown = -1;
+int ghostRow() {
+	if(game->gui[TextGG] || !game->canRelease()) return -1;
+	int y = game->landingRow();
+	return y < game->currTilePos.y ? y : -1;
 }
 
-// When the current tile is moved or rotated (or created), update the VBO containing its vertex position data
+// When the current tile is moved or rotated (or created), update the VBO containing its vertex position data;
+// the ghost's cubes follow the tile's in the same VBO
 void updatetile() {
-	if(gui[TextGG]) return;
-	if(!tileFalling)
-		currTilePos = robot::getTip();
+	if(game->gui[TextGG]) return;
 
-	if(canRelease()) {
+	if(game->canRelease()) {
 		updateTileColours();
 	} else {
 		vec4 newcolours[24*6];
 		for (int i = 0; i < 24*6; i++)
 			newcolours[i] = grey;
 		glBindBuffer(GL_ARRAY_BUFFER, vboIDs[CurrentTileColourBO]); // Bind the VBO containing current tile vertex colours
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(newcolours), newcolours); // Put the colour data in the VBO
+		bufferColours(0, 24*6, newcolours); // Put the colour data in the VBO
 	}
 
 	// Bind the VBO containing current tile vertex positions
 	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[CurrentTilePositionBO]); 
 
-	// For each of the 4 'cells' of the tile,
-	for (int i = 0; i < 4; i++) 
-	{
-		// Calculate the grid coordinates of the cell
-		GLfloat x = currTilePos.x + currTileOffset[i].x; 
-		GLfloat y = currTilePos.y + currTileOffset[i].y;
-
-		// Create the 4 corners of the square - these vertices are using location in pixels
-		// These vertices are later converted by the vertex shader
-		vec4 p1 = vec4(33.0 + (x * 33.0), 33.0 + (y * 33.0), 16.50, 1); // front left bottom
-		vec4 p2 = vec4(33.0 + (x * 33.0), 66.0 + (y * 33.0), 16.50, 1); // front left top
-		vec4 p3 = vec4(66.0 + (x * 33.0), 33.0 + (y * 33.0), 16.50, 1); // front right bottom
-		vec4 p4 = vec4(66.0 + (x * 33.0), 66.0 + (y * 33.0), 16.50, 1); // front right top
-		vec4 p5 = vec4(33.0 + (x * 33.0), 33.0 + (y * 33.0), -16.50, 1); // back left bottom
-		vec4 p6 = vec4(33.0 + (x * 33.0), 66.0 + (y * 33.0), -16.50, 1); // back left top
-		vec4 p7 = vec4(66.0 + (x * 33.0), 33.0 + (y * 33.0), -16.50, 1); // back right bottom
-		vec4 p8 = vec4(66.0 + (x * 33.0), 66.0 + (y * 33.0), -16.50, 1); // back right top
-
-		// Two points are used by two triangles each
-		vec4 newpoints[36] = {	p1, p2, p3, p2, p3, p4,
-								p5, p6, p7, p6, p7, p8,
-								p1, p2, p5, p2, p5, p6,
-								p3, p4, p7, p4, p7, p8,
-								p2, p4, p6, p4, p6, p8,
-								p1, p3, p5, p3, p5, p7};
-
-		// Put new data in the VBO
-		glBufferSubData(GL_ARRAY_BUFFER, i*sizeof(newpoints), sizeof(newpoints), newpoints); 
-	}
-}
-
-//-------------------------------------------------------------------------------------------------------------------
-
-// Called to keep the tile within the bounds of the board by nudging the tile into place
-bool nudgeCurrentTile(const vec2 *o) {
+	// a cube for each of the 4 cells of the tile
 	for(int i = 0; i < 4; i++) {
-		vec2 p = currTilePos + o[i];
-		if(isInBoardBounds(p) && isCellOccupied(p)) return false;
+		Cell c = game->currTilePos + game->currTileOffset[i];
+		vec4 cubepoints[36];
+		cellCube(cubepoints, c.x, c.y);
+		bufferPositions(36*i, 36, cubepoints, BOARD_POSITION_UNIT);
 	}
-	for(int i = 0; i < 4; i++) {
-		vec2 p = currTilePos + o[i];
-		if(!isInBoardBounds(p)) currTilePos -= o[i];
+
+	ghostRowShown = ghostRow();
+	for(int i = 0; ghostRowShown >= 0 && i < 4; i++) {
+		vec4 cubepoints[36];
+		cellCube(cubepoints, game->currTilePos.x + game->currTileOffset[i].x, ghostRowShown + game->currTileOffset[i].y);
+		bufferPositions(24*6 + 36*i, 36, cubepoints, BOARD_POSITION_UNIT);
 	}
-	return true;
-}
-bool nudgeCurrentTile(int cellOffsetX, int cellOffsetY) {
-	int cellX = currTilePos.x + cellOffsetX;
-	int cellY = currTilePos.y + cellOffsetY;
-	if(isInBoardBounds(cellX,cellY) && isCellOccupied(cellX, cellY)) return false;
-	currTilePos.x -= cellX<0 ? cellOffsetX : cellX>BOARD_WIDTH - 1 ? cellOffsetX : 0;
-	currTilePos.y -= cellY>BOARD_HEIGHT - 1 ? cellOffsetY : cellY<0 ? cellOffsetY : 0;
-	return true;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 
 void updateTileColours() {
-	// Update the color VBO of current tile
-	vec4 newcolours[24*6];
-	for (int i = 0; i < 24*6; i++)
-		newcolours[i] = currTileColours[i/6/6];
+	// Update the color VBO of current tile, then of its ghost
+	vec4 newcolours[2*24*6];
+	for (int i = 0; i < 2*24*6; i++) {
+		newcolours[i] = fruitColour(game->currTileFruits[i/6/6 % 4]);
+		newcolours[i].w *= i < 24*6 ? fadeOut : fadeOut*GHOST_ALPHA;
+	}
 	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[CurrentTileColourBO]); // Bind the VBO containing current tile vertex colours
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(newcolours), newcolours); // Put the colour data in the VBO
+	bufferColours(0, 2*24*6, newcolours); // Put the colour data in the VBO
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-void shuffleAndUpdateColours() {
-	vec4 temp = currTileColours[0];
-	for(int i = 0; i < 4 - 1; i++)
-		currTileColours[i] = currTileColours[i + 1];
-	currTileColours[3] = temp;
-	
-	updateTileColours();
-}
-
-//-------------------------------------------------------------------------------------------------------------------
-
-// Called at the start of play and every time a tile is placed
-void newtile() {
-	if(gui[TextGG]) return;
-	tileDropSpeed = TILE_DROP_SPEED;
-	//vec4 p1 = vec4(33.0 + (x * 33.0), 33.0 + (y * 33.0), 16.50, 1); // front left bottom
-	//currTilePos = vec2(rand() % BOARD_WIDTH, BOARD_HEIGHT - 1); // Put the tile at the top of the board
-	currTilePos = robot::getTip();
-
-	// Update the geometry VBO of current tile
-	currTileShapeIndex = rand() % MaxTileShapes;
-	for(int i = 0; i < 4; i++) {
-		currTileColours[i] = fruitColours[rand() % MaxFruitColours];
-		currTileOffset[i] = allShapes[currTileShapeIndex][i];
-		//nudgeCurrentTile(currTileOffset[i].x, currTileOffset[i].y);
-	}
-	rotateCurrentTile(rand() % 5);
-	shuffleAndUpdateColours();
-	updatetile(); 
-
-	// can't lose! ;)
-	/*for(int i = 0; i < 4; i++) {
-		if(isCellOccupied(currTilePos + currTileOffset[i])) {
-			gui[TextGG] = 1;
-		}
-	}*/
-	glBindVertexArray(0);
-}
-
-//-------------------------------------------------------------------------------------------------------------------
-
 void initGrid() {
-	// 462 = 21*11*2 is depth lines
-	vec4 gridpoints[64*2 + 462];
-	vec4 gridcolours[64*2 + 462];
+	// the front face, then the back face, then the depth lines
+	vec4 gridpoints[GRID_POINTS];
+	vec4 gridcolours[GRID_POINTS];
+	const GLfloat gridRight = 33.0*(BOARD_WIDTH + 1), gridTop = 33.0*(BOARD_HEIGHT + 1);
+	const int back = GRID_FACE_POINTS, rows = 2*(BOARD_WIDTH + 1), depth = 2*GRID_FACE_POINTS;
 	// Vertical lines 
-	for (int i = 0; i < 11; i++){
-		gridpoints[2*i]      = vec4((33.0 + (33.0 * i)), 33.0, 16.50, 1);
-		gridpoints[2*i + 1]  = vec4((33.0 + (33.0 * i)), 693.0, 16.50, 1);
-		gridpoints[2*i + 64] = vec4((33.0 + (33.0 * i)), 33.0, -16.50, 1);
-		gridpoints[2*i + 65] = vec4((33.0 + (33.0 * i)), 693.0, -16.50, 1);
+	for (int i = 0; i < BOARD_WIDTH + 1; i++){
+		gridpoints[2*i]      		= vec4((33.0 + (33.0 * i)), 33.0, 16.50, 1);
+		gridpoints[2*i + 1]  		= vec4((33.0 + (33.0 * i)), gridTop, 16.50, 1);
+		gridpoints[2*i + back] 		= vec4((33.0 + (33.0 * i)), 33.0, -16.50, 1);
+		gridpoints[2*i + back + 1] 	= vec4((33.0 + (33.0 * i)), gridTop, -16.50, 1);
 	}
 	// Horizontal lines
-	for (int i = 0; i < 21; i++){
-		gridpoints[22 + 2*i] 		= vec4(33.0, (33.0 + (33.0 * i)), 16.50, 1);
-		gridpoints[22 + 2*i + 1] 	= vec4(363.0, (33.0 + (33.0 * i)), 16.50, 1);
-		gridpoints[22 + 2*i + 64]	= vec4(33.0, (33.0 + (33.0 * i)), -16.50, 1);
-		gridpoints[22 + 2*i + 65] 	= vec4(363.0, (33.0 + (33.0 * i)), -16.50, 1);
+	for (int i = 0; i < BOARD_HEIGHT + 1; i++){
+		gridpoints[rows + 2*i] 				= vec4(33.0, (33.0 + (33.0 * i)), 16.50, 1);
+		gridpoints[rows + 2*i + 1] 			= vec4(gridRight, (33.0 + (33.0 * i)), 16.50, 1);
+		gridpoints[rows + 2*i + back]		= vec4(33.0, (33.0 + (33.0 * i)), -16.50, 1);
+		gridpoints[rows + 2*i + back + 1] 	= vec4(gridRight, (33.0 + (33.0 * i)), -16.50, 1);
 	}
 	// Depth lines
 	for (int i = 0; i < BOARD_HEIGHT + 1; i++){
 		for (int j = 0; j < BOARD_WIDTH + 1; j++) {
-			gridpoints[128 + 22*i + 2*j] 		= vec4(33.0 + (j * 33.0), 33.0 + (i * 33.0), 16.50, 1); // front left bottom
-			gridpoints[128 + 22*i + 2*j + 1] 	= vec4(33.0 + (j * 33.0), 33.0 + (i * 33.0), -16.50, 1); // back left bottom
+			gridpoints[depth + rows*i + 2*j] 		= vec4(33.0 + (j * 33.0), 33.0 + (i * 33.0), 16.50, 1); // front left bottom
+			gridpoints[depth + rows*i + 2*j + 1] 	= vec4(33.0 + (j * 33.0), 33.0 + (i * 33.0), -16.50, 1); // back left bottom
 		}
 	}
 	// Make all grid lines coloured
-	for (int i = 0; i < 64*2 + 462; i++)
+	for (int i = 0; i < GRID_POINTS; i++)
 		gridcolours[i] = gridColour;
 
 
@@ -392,15 +264,15 @@ void initGrid() {
 
 	// Grid vertex positions
 	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[GridPositionBO]); // Bind the first grid VBO (vertex positions)
-	glBufferData(GL_ARRAY_BUFFER, (128 + 462)*sizeof(vec4), gridpoints, GL_DYNAMIC_DRAW); // Put the grid points in the VBO
-	glVertexAttribPointer(vPosition, 4, GL_FLOAT, GL_FALSE, 0, 0);
-	glEnableVertexAttribArray(vPosition); // Enable the attribute
+	glBufferData(GL_ARRAY_BUFFER, GRID_POINTS*positionSize(), NULL, GL_DYNAMIC_DRAW);
+	bufferPositions(0, GRID_POINTS, gridpoints, BOARD_POSITION_UNIT); // Put the grid points in the VBO
+	positionPointer(vPosition, 0); // Enable the attribute
 	
 	// Grid vertex colours
 	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[GridColourBO]); // Bind the second grid VBO (vertex colours)
-	glBufferData(GL_ARRAY_BUFFER, (128 + 462)*sizeof(vec4), gridcolours, GL_DYNAMIC_DRAW); // Put the grid colours in the VBO
-	glVertexAttribPointer(vColor, 4, GL_FLOAT, GL_FALSE, 0, 0);
-	glEnableVertexAttribArray(vColor); // Enable the attribute
+	glBufferData(GL_ARRAY_BUFFER, GRID_POINTS*colourSize(), NULL, GL_DYNAMIC_DRAW);
+	bufferColours(0, GRID_POINTS, gridcolours); // Put the grid colours in the VBO
+	colourPointer(vColor, 0); // Enable the attribute
 }
 
 void face(vec4 *boardpoints, int index, vec4 &p1, vec4 &p2, vec4 &p3, vec4 &p4) {
@@ -412,38 +284,80 @@ void face(vec4 *boardpoints, int index, vec4 &p1, vec4 &p2, vec4 &p3, vec4 &p4)
 	boardpoints[index + 5] = p4;
 }
 
+// Fills the 36 vertices of the cube of cell (x,y); y may be fractional while a cell is falling
+void cellCube(vec4 *cubepoints, float x, float y) {
+	vec4 p1 = vec4(33.0 + (x * 33.0), 33.0 + (y * 33.0), 16.50, 1); // front left bottom
+	vec4 p2 = vec4(33.0 + (x * 33.0), 66.0 + (y * 33.0), 16.50, 1); // front left top
+	vec4 p3 = vec4(66.0 + (x * 33.0), 33.0 + (y * 33.0), 16.50, 1); // front right bottom
+	vec4 p4 = vec4(66.0 + (x * 33.0), 66.0 + (y * 33.0), 16.50, 1); // front right top
+	vec4 p5 = vec4(33.0 + (x * 33.0), 33.0 + (y * 33.0), -16.50, 1); // back left bottom
+	vec4 p6 = vec4(33.0 + (x * 33.0), 66.0 + (y * 33.0), -16.50, 1); // back left top
+	vec4 p7 = vec4(66.0 + (x * 33.0), 33.0 + (y * 33.0), -16.50, 1); // back right bottom
+	vec4 p8 = vec4(66.0 + (x * 33.0), 66.0 + (y * 33.0), -16.50, 1); // back right top
+	face(cubepoints, 0 , p1, p2, p3, p4); // front
+	face(cubepoints, 6 , p5, p6, p7, p8); // back
+	face(cubepoints, 12, p1, p2, p5, p6); // left
+	face(cubepoints, 18, p3, p4, p7, p8); // right
+	face(cubepoints, 24, p2, p4, p6, p8); // up
+	face(cubepoints, 30, p1, p3, p5, p7); // down
+}
+
+// One unit cube at cell (0,0), each instance is moved to its cell by the vertex shader
+void initBoardInstanced() {
+	vec4 cubepoints[36];
+	cellCube(cubepoints, 0, 0);
+
+	GLushort cells[BOARD_WIDTH*BOARD_HEIGHT];
+	for (int i = 0; i < BOARD_WIDTH*BOARD_HEIGHT; i++) {
+		cells[i] = i;
+		for (int k = 0; k < 4; k++) boardcellcolours[i][k] = 0;
+	}
+
+	// *** set up buffer objects
+	glBindVertexArray(vaoIDs[VAOBoard]);
+	glGenBuffers(2, &vboIDs[BoardPositionBO]);
+	glGenBuffers(2, &vboIDs[BoardCellBO]);
+
+	// Cube vertex positions
+	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[BoardPositionBO]);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(cubepoints), cubepoints, GL_STATIC_DRAW);
+	glVertexAttribPointer(boardPosition, 4, GL_FLOAT, GL_FALSE, 0, 0);
+	glEnableVertexAttribArray(boardPosition);
+
+	// Index of the cell each instance is drawn at
+	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[BoardCellBO]);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(cells), cells, GL_STATIC_DRAW);
+	glVertexAttribIPointer(boardCell, 1, GL_UNSIGNED_SHORT, 0, 0);
+	glVertexAttribDivisor(boardCell, 1);
+	glEnableVertexAttribArray(boardCell);
+
+	// Rows each instance is drawn above its cell while falling
+	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[BoardDropBO]);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(animation.drop), animation.drop, GL_DYNAMIC_DRAW);
+	glVertexAttribPointer(boardDrop, 1, GL_FLOAT, GL_FALSE, 0, 0);
+	glVertexAttribDivisor(boardDrop, 1);
+	glEnableVertexAttribArray(boardDrop);
+
+	// Cell colours, one RGBA8 per instance
+	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[BoardColourBO]);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(boardcellcolours), boardcellcolours, GL_DYNAMIC_DRAW);
+	glVertexAttribPointer(boardColour, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+	glVertexAttribDivisor(boardColour, 1);
+	glEnableVertexAttribArray(boardColour);
+}
+
 void initBoard() {
+	boardDirty.fill();
+	if(instancedBoard) { initBoardInstanced(); return; }
+
 	// *** Generate the geometric data
 	vec4 boardpoints[BOARD_POINTS];
 	for (int i = 0; i < BOARD_POINTS; i++)
 		boardcolours[i] = cellFreeColour;
 	// Each cell is a square (2 triangles with 6 vertices)
-	for (int i = 0; i < BOARD_HEIGHT; i++){
+	for (int i = 0; i < BOARD_HEIGHT; i++)
 		for (int j = 0; j < BOARD_WIDTH; j++)
-		{
-			vec4 p1 = vec4(33.0 + (j * 33.0), 33.0 + (i * 33.0), 16.50, 1); // front left bottom
-			vec4 p2 = vec4(33.0 + (j * 33.0), 66.0 + (i * 33.0), 16.50, 1); // front left top
-			vec4 p3 = vec4(66.0 + (j * 33.0), 33.0 + (i * 33.0), 16.50, 1); // front right bottom
-			vec4 p4 = vec4(66.0 + (j * 33.0), 66.0 + (i * 33.0), 16.50, 1); // front right top
-			vec4 p5 = vec4(33.0 + (j * 33.0), 33.0 + (i * 33.0), -16.50, 1); // back left bottom
-			vec4 p6 = vec4(33.0 + (j * 33.0), 66.0 + (i * 33.0), -16.50, 1); // back left top
-			vec4 p7 = vec4(66.0 + (j * 33.0), 33.0 + (i * 33.0), -16.50, 1); // back right bottom
-			vec4 p8 = vec4(66.0 + (j * 33.0), 66.0 + (i * 33.0), -16.50, 1); // back right top
-			
-			int index = 36*(BOARD_WIDTH*i + j);
-			face(boardpoints, index     , p1, p2, p3, p4); // front
-			face(boardpoints, index + 6 , p5, p6, p7, p8); // back
-			face(boardpoints, index + 12, p1, p2, p5, p6); // left
-			face(boardpoints, index + 18, p3, p4, p7, p8); // right
-			face(boardpoints, index + 24, p2, p4, p6, p8); // up
-			face(boardpoints, index + 30, p1, p3, p5, p7); // down
-		}
-	}
-
-	// Initially no cell is occupied
-	for (int i = 0; i < BOARD_WIDTH; i++)
-		for (int j = 0; j < BOARD_HEIGHT; j++)
-			board[i][j] = false; 
+			cellCube(&boardpoints[36*(BOARD_WIDTH*i + j)], j, i);
 
 
 	// *** set up buffer objects
@@ -452,39 +366,64 @@ void initBoard() {
 
 	// Grid cell vertex positions
 	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[BoardPositionBO]);
-	glBufferData(GL_ARRAY_BUFFER, BOARD_POINTS*sizeof(vec4), boardpoints, GL_STATIC_DRAW);
-	glVertexAttribPointer(vPosition, 4, GL_FLOAT, GL_FALSE, 0, 0);
-	glEnableVertexAttribArray(vPosition);
+	glBufferData(GL_ARRAY_BUFFER, BOARD_POINTS*positionSize(), NULL, GL_STATIC_DRAW);
+	bufferPositions(0, BOARD_POINTS, boardpoints, BOARD_POSITION_UNIT);
+	positionPointer(vPosition, 0);
 
 	// Grid cell vertex colours
 	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[BoardColourBO]);
-	glBufferData(GL_ARRAY_BUFFER, BOARD_POINTS*sizeof(vec4), boardcolours, GL_DYNAMIC_DRAW);
-	glVertexAttribPointer(vColor, 4, GL_FLOAT, GL_FALSE, 0, 0);
-	glEnableVertexAttribArray(vColor);
+	glBufferData(GL_ARRAY_BUFFER, BOARD_POINTS*colourSize(), NULL, GL_DYNAMIC_DRAW);
+	bufferColours(0, BOARD_POINTS, boardcolours);
+	colourPointer(vColor, 0);
 }
 
-// No geometry for current tile initially
+// No geometry for current tile initially; room for the tile and its ghost
 void initCurrentTile() {
 	glBindVertexArray(vaoIDs[VAOTile]);
 	glGenBuffers(2, &vboIDs[CurrentTilePositionBO]);
 
 	// Current tile vertex positions
 	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[CurrentTilePositionBO]);
-	glBufferData(GL_ARRAY_BUFFER, 24*6*sizeof(vec4), NULL, GL_DYNAMIC_DRAW);
-	glVertexAttribPointer(vPosition, 4, GL_FLOAT, GL_FALSE, 0, 0);
-	glEnableVertexAttribArray(vPosition);
+	glBufferData(GL_ARRAY_BUFFER, 2*24*6*positionSize(), NULL, GL_DYNAMIC_DRAW);
+	positionPointer(vPosition, 0);
 
 	// Current tile vertex colours
 	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[CurrentTileColourBO]);
-	glBufferData(GL_ARRAY_BUFFER, 24*6*sizeof(vec4), NULL, GL_DYNAMIC_DRAW);
-	glVertexAttribPointer(vColor, 4, GL_FLOAT, GL_FALSE, 0, 0);
-	glEnableVertexAttribArray(vColor);
+	glBufferData(GL_ARRAY_BUFFER, 2*24*6*colourSize(), NULL, GL_DYNAMIC_DRAW);
+	colourPointer(vColor, 0);
+}
+
+void resetView() {
+	// Board is now in unit lengths
+	vec3 topOfBoard = vec3(0, BOARD_HEIGHT + 10, 24);
+	vec3 centerOfBoard = vec3(0, BOARD_HEIGHT/2, 0);
+	View = LookAt(
+			topOfBoard,
+			centerOfBoard,
+			vec3(0, 1, 0));
+	fadeOut = 1.0f;
 }
 
 void init() {
+	// Draw the board with one instanced call if the GL can
+	instancedBoard = GLEW_VERSION_3_3;
+	if(instancedBoard) {
+		boardProgram = InitShader("boardvshader.glsl", "fshader.glsl");
+		glUseProgram(boardProgram);
+		boardPosition = glGetAttribLocation(boardProgram, "vPosition");
+		boardCell = glGetAttribLocation(boardProgram, "vCell");
+		boardColour = glGetAttribLocation(boardProgram, "vColor");
+		boardDrop = glGetAttribLocation(boardProgram, "vDrop");
+		locBoardMVP = glGetUniformLocation(boardProgram, "MVP");
+		glUniform1ui(glGetUniformLocation(boardProgram, "boardWidth"), BOARD_WIDTH);
+	}
+
 	// Load shaders and use the shader program
-	GLuint program = InitShader("vshader.glsl", "fshader.glsl");
+	program = InitShader(vertexShader(), "fshader.glsl");
 	glUseProgram(program);
+	// only the packed layout scales positions, -1 (ignored) otherwise
+	locPositionUnit = glGetUniformLocation(program, "positionUnit");
+	glUniform1f(locPositionUnit, BOARD_POSITION_UNIT);
 
 	// Get the location of the attributes (for glVertexAttribPointer() calls)
 	vPosition = glGetAttribLocation(program, "vPosition");
@@ -493,35 +432,25 @@ void init() {
 	// Create 3 Vertex Array Objects, each representing one 'object'. Store the names in array vaoIDs
 	glGenVertexArrays(3, &vaoIDs[0]);
 
+	text.init(MaxHudTexts);
+	text.resize(xsize, ysize);
+
 	// Initialize the grid, the board, and the current tile
 	initGrid();
 	initBoard();
 	initCurrentTile();
-	robot::init();
-	robot::Theta[robot::LowerArm] = 5;
-	robot::Theta[robot::UpperArm] = -85;
-
 	// The location of the uniform variables in the shader program
 	locMVP = glGetUniformLocation(program, "MVP");
+	robotModel.init(vPosition, vColor, locMVP);
+	// Draw the robot with one instanced call for its three parts if the GL can too
+	instancedRobot = GLEW_VERSION_3_3;
+	if(instancedRobot) {
+		robotProgram = InitShader("robotvshader.glsl", "fshader.glsl");
+		robotModel.initInstanced(robotProgram);
+	}
 
-	// Board is now in unit lengths
-	vec3 topOfBoard = vec3(0, BOARD_HEIGHT + 10, 24);
-	vec3 centerOfBoard = vec3(0, BOARD_HEIGHT/2, 0);
-	View = LookAt(
-			topOfBoard,
-			centerOfBoard,
-			vec3(0, 1, 0));
-
-	// Game initialization
-	// reset variables 
-	fadeOut = 1.0f;
-	gui[TextGG] = 0;
-	gui[TextScore] = 0;
-	gui[TextCells] = 0;
-	gui[TextRows] = 0;
-	gui[GripTime] = MAX_GRIP_TIME;
-
-	newtile(); // create new next tile
+	resetView();
+	updatetile();
 
 	// Blend
    	glEnable(GL_BLEND); 
@@ -542,121 +471,186 @@ void init() {
 
 //-------------------------------------------------------------------------------------------------------------------
 
-// Rotates the current tile, nudge to make room
-void rotateCurrentTile(int n) {
-	if(currTileShapeIndex == TileShapeO) { shuffleAndUpdateColours(); return; }
-	vec2 nextOrientation[4];
-	for(int i = 0; i < 4; i++) nextOrientation[i] = vec2(currTileOffset[i].y, -currTileOffset[i].x);
-	// rotate additional n times for random rotation
-	for(int k = 0; k < n; k++) 
-		for(int i = 0; i < 4; i++) nextOrientation[i] = vec2(nextOrientation[i].y, -nextOrientation[i].x);
-	// if cannot nudge tile back into valid bounds, cancel rotation
-	if(!nudgeCurrentTile(nextOrientation)) return;
-	// otherwise apply this rotation
-	for(int i = 0; i < 4; i++) currTileOffset[i] = nextOrientation[i];
+// Uploads the colours of cells first to last
+void uploadBoardColours(int first, int last) {
+	if(instancedBoard)
+		glBufferSubData(GL_ARRAY_BUFFER, first*sizeof(boardcellcolours[0]), (last - first + 1)*sizeof(boardcellcolours[0]), boardcellcolours[first]);
+	else
+		bufferColours(36*first, 36*(last - first + 1), &boardcolours[36*first]);
 }
 
-//-------------------------------------------------------------------------------------------------------------------
-// sets colour of the specified board to c
-void setCellColour(const vec2 &p, const vec4 &c) {
-	for(int i = 0; i < 36; i++) {
-		int index = 36*(BOARD_WIDTH*(int)p.y + (int)p.x) + i;
-		boardcolours[index] = c;
+// Sets the colour of cell i in whichever buffer the board is drawn from
+void setBoardColour(int i, const vec4 &c) {
+	if(instancedBoard) {
+		packColour(c, boardcellcolours[i]);
+	} else {
+		for(int k = 0; k < 36; k++)
+			boardcolours[36*i + k] = c;
 	}
 }
-void setCellColour(int x, int y, const vec4 &c) {
-	setCellColour(vec2(x, y), c);
-}
 
-// Places the current tile - update the board vertex colour VBO and the array maintaining occupied cells
-void setTileColour(const vec2 &p) {
-	for(int i = 0; i < 4; i++) {
-		int cellX = p.x + currTileOffset[i].x;
-		int cellY = p.y + currTileOffset[i].y;
-		board[cellX][cellY] = true;
-		setCellColour(cellX, cellY, currTileColours[i]);
+// Copies the colour of every changed game cell into the board's buffer, uploading only the runs of cells that changed;
+// removed cells keep their colour while they fade out
+void updateBoard() {
+	const Bitboard &changed = game->getDirtyCells();
+	for (int y = 0; y < BOARD_HEIGHT; y++)
+		boardDirty.rows[y] |= changed.rows[y];
+	game->clearDirtyCells();
+	// fading out on game over changes every cell
+	if(fadeOut != boardFadeOut) {
+		boardDirty.fill();
+		boardFadeOut = fadeOut;
 	}
-}
 
-vec4 getCellColour(const vec2 &p) {
-	return boardcolours[36*(10*(int)p.y + (int)p.x)];
+	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[BoardColourBO]);
+	int first = -1, last = -1;
+	for (int y = 0; y < BOARD_HEIGHT; y++) {
+		if(!boardDirty.rows[y]) continue;
+		for (int x = 0; x < BOARD_WIDTH; x++) {
+			if(!boardDirty.isOccupied(x, y)) continue;
+			int i = BOARD_WIDTH*y + x;
+			vec4 c = cellFreeColour;
+			if(game->isCellOccupied(x, y)) c = fruitColour(game->getCellFruit(x, y));
+			else if(animation.fade[i] > 0) c = fruitColour(game->getCellFruit(x, y)) * vec4(1, 1, 1, animation.fade[i]);
+			c.w *= fadeOut;
+			setBoardColour(i, c);
+			// cells are laid out row by row, so runs continue across rows
+			if(first >= 0 && i - last > BOARD_UPLOAD_GAP + 1) {
+				uploadBoardColours(first, last);
+				first = -1;
+			}
+			if(first < 0) first = i;
+			last = i;
+		}
+	}
+	if(first >= 0) uploadBoardColours(first, last);
+	boardDirty.clear();
+}
+
+// Moves the falling cells of collapsed columns down to where they should be drawn by now, and uploads their offsets
+void updateDrops() {
+	int moved[BOARD_WIDTH*BOARD_HEIGHT];
+	int n = animation.stepDrops(game->now(), moved);
+	if(!n) return;
+	if(instancedBoard) {
+		glBindBuffer(GL_ARRAY_BUFFER, vboIDs[BoardDropBO]);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(animation.drop), animation.drop);
+		return;
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[BoardPositionBO]);
+	for(int k = 0; k < n; k++) {
+		int i = moved[k];
+		vec4 cubepoints[36];
+		cellCube(cubepoints, i % BOARD_WIDTH, i / BOARD_WIDTH + animation.drop[i]);
+		bufferPositions(36*i, 36, cubepoints, BOARD_POSITION_UNIT);
+	}
 }
 
-// checks if cell is able to fall, returns true if able, false otherwise
-bool cellFreeToFall(const vec2 &p) {
-	if((int)p.y - 1 < 0) return false;
-	return !isCellOccupied(p - vec2(0, 1));
-}
+//-------------------------------------------------------------------------------------------------------------------
 
-bool tileFreeToFall(const vec2 &p) {
-	for(int i = 0; i < 4; i++) {
-		if(!cellFreeToFall(p + currTileOffset[i]))
-			return false;
-	}
-	return true;
+// Applies what changed in a game step or tick: starts fading removed cells, starts the fall of collapsed cells from
+// wherever they were drawn, and redraws the tile, or its ghost when the board under it changed
+void handleStep(const StepResult &r) {
+	animation.start(r, game->now());
+	if(r.tileChanged || ghostRow() != ghostRowShown)
+		updatetile();
+}
+void stepGame(GameInput input) {
+	handleStep(game->step(input));
 }
 
-void updateBoard() {
-	glBindBuffer(GL_ARRAY_BUFFER, vboIDs[BoardColourBO]); 
-	glBufferData(GL_ARRAY_BUFFER, BOARD_POINTS*sizeof(vec4), boardcolours, GL_DYNAMIC_DRAW);
+// Runs the game clock at wall-clock rate, one game tick for every TICK_MS that has passed
+int lastTickTime;
+void gameClock(int) {
+	int t = glutGet(GLUT_ELAPSED_TIME);
+	// don't catch up on more than a second, e.g. after the window was dragged around
+	if(t - lastTickTime > 1000) lastTickTime = t - 1000;
+	for(; lastTickTime + TICK_MS <= t; lastTickTime += TICK_MS)
+		handleStep(game->tick());
+	glutTimerFunc(TICK_MS, gameClock, 0);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 
-// Given (x,y), tries to move the tile x squares to the right and y squares down
-// Returns true if the tile was successfully moved, or false if there was some issue
-bool moveTile(vec2 direction) {
-	for (int i = 0; i < 4; i++) {
-		vec2 newPos = currTilePos + currTileOffset[i] + direction;
-		if(!isInBoardBounds(newPos) || isCellOccupied(newPos))
-			return false;
+// HUD strings and the game values they were last formatted from, so they are only formatted when a value changes
+string tilePositionText, scoreText, gripTimeText;
+Cell tilePositionShown(-1, -1);
+float scoreShown[3] = {-1, -1, -1}, gripTimeShown = -1;
+
+void updateHudStrings() {
+	if(game->currTilePos != tilePositionShown) {
+		tilePositionShown = game->currTilePos;
+		ostringstream ss;
+		ss << "Tile position: " << tilePositionShown.x << ',' << tilePositionShown.y;
+		tilePositionText = ss.str();
+	}
+	if(game->gui[TextScore] != scoreShown[0] || game->gui[TextCells] != scoreShown[1] || game->gui[TextRows] != scoreShown[2]) {
+		scoreShown[0] = game->gui[TextScore];
+		scoreShown[1] = game->gui[TextCells];
+		scoreShown[2] = game->gui[TextRows];
+		ostringstream ss;
+		ss << "Score: " << scoreShown[0] << " Cells Deleted: " << scoreShown[1] << " Rows Deleted: " << scoreShown[2];
+		scoreText = ss.str();
+	}
+	if(game->gui[GripTime] != gripTimeShown) {
+		gripTimeShown = game->gui[GripTime];
+		ostringstream ss;
+		ss << "Gripper Time Remaining: " << gripTimeShown;
+		gripTimeText = ss.str();
 	}
-	return true;
-}
-//-------------------------------------------------------------------------------------------------------------------
-
-// generically draws text to screen
-template<class T>
-void drawText(T str, float x, float y) {
-	stringstream ss(str);
-	glRasterPos2f(x, y);
-	char c;
-	while(ss >> noskipws >> c) glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, c);
 }
 
 // Starts the game over - empties the board, creates new tiles, resets line counters
 void restart()
 {
-	numDropTileCallbacks = numFastDropTileCallbacks = numCheckFruitColumnCallbacks = 0;
-	init();
+	animation.clear();
+	boardDirty.fill();
+	resetView();
+	stepGame(InputRestart);
 }
 //-------------------------------------------------------------------------------------------------------------------
 
 // moving text!
 float x = -1.0f;
 float y = 0.7f;
+// Summarizes the last PROFILE_WINDOW frames, one line per stage
+void updateProfileLines() {
+	profileLines.clear();
+	profileLines.push_back(profiler.hasGpu() ? "stage: cpu / gpu p50 p95 p99 (us)" : "stage: cpu p50 p95 p99 (us)");
+	for(int i = 0; i < MaxProfileStages; i++) {
+		ProfileStage st = (ProfileStage)i;
+		ostringstream ss;
+		ss.setf(ios::fixed); ss.precision(0);
+		ss << profileStageNames[i] << ": " << profiler.cpuPercentile(st, 50) << ' ' << profiler.cpuPercentile(st, 95)
+		   << ' ' << profiler.cpuPercentile(st, 99);
+		if(profiler.hasGpu())
+			ss << " / " << profiler.gpuPercentile(st, 50) << ' ' << profiler.gpuPercentile(st, 95) << ' ' << profiler.gpuPercentile(st, 99);
+		profileLines.push_back(ss.str());
+	}
+}
+
 // Draws the game
 void display() {
+	profiler.beginFrame();
+	profiler.begin(StageFrame);
+	glUseProgram(program);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-	glColor4f(1.0f, 0.0f, 0.0f, fadeOut);
 
 	Projection = Perspective(45, 1.0*xsize/ysize, 10, 200);
 
 	// Draw the robot
-    glBindVertexArray(robot::vao);
-	mat4 f = Projection * View * Translate(robot::pos);
-	robot::robotMVP = RotateY(robot::Theta[robot::Base] );
-	robot::base(f);
-
-	robot::robotMVP *= Translate(0.0, robot::BASE_HEIGHT, 0.0);
-	robot::robotMVP *= RotateZ(robot::Theta[robot::LowerArm]);
-	robot::lower_arm(f);
-
-	robot::robotMVP *= Translate(0.0, robot::LOWER_ARM_HEIGHT, 0.0);
-	robot::robotMVP *= RotateZ(robot::Theta[robot::UpperArm]);
-	robot::upper_arm(f);
-
-	robot::robotMVP *= Translate(0.0, robot::UPPER_ARM_HEIGHT, 0.0);
+	{
+	ProfileScope scope(profiler, StageRobot);
+	if(instancedRobot) {
+		glUseProgram(robotProgram);
+		robotModel.drawInstanced(Projection * View, game->arm);
+		glUseProgram(program);
+	} else {
+		glUniform1f(locPositionUnit, robot::PositionUnit);
+		robotModel.draw(Projection * View, game->arm);
+		glUniform1f(locPositionUnit, BOARD_POSITION_UNIT);
+	}
+	}
 
 	// Scale everything to unit length
 	mat4 Model = mat4();
@@ -667,80 +661,82 @@ void display() {
 	mat4 MVP = Projection * View * Model;
 	setMVP(MVP);
 
+	profiler.begin(StageBoard);
 	glBindVertexArray(vaoIDs[VAOBoard]); // Bind the VAO representing the grid cells (to be drawn first)
-	glDrawArrays(GL_TRIANGLES, 0, BOARD_POINTS); // Draw the board (10*20*2 = 400 triangles)
+	if(instancedBoard) {
+		glUseProgram(boardProgram);
+		glUniformMatrix4fv(locBoardMVP, 1, GL_TRUE, MVP);
+		glDrawArraysInstanced(GL_TRIANGLES, 0, 36, BOARD_WIDTH*BOARD_HEIGHT); // Draw one cube per cell
+		glUseProgram(program);
+	} else {
+		glDrawArrays(GL_TRIANGLES, 0, BOARD_POINTS); // Draw the board (12 triangles per cell)
+	}
+	profiler.end(StageBoard);
 
+	profiler.begin(StageTile);
 	glBindVertexArray(vaoIDs[VAOTile]); // Bind the VAO representing the current tile (to be drawn on top of the board)
-	glDrawArrays(GL_TRIANGLES, 0, 24*6); // Draw the current tile (8 triangles)
+	glDrawArrays(GL_TRIANGLES, 0, ghostRowShown >= 0 ? 2*24*6 : 24*6); // Draw the current tile and its ghost
+	profiler.end(StageTile);
 
+	profiler.begin(StageGrid);
 	glBindVertexArray(vaoIDs[VAOGrid]); // Bind the VAO representing the grid lines (to be drawn on top of everything else)
-	glDrawArrays(GL_LINES, 0, 128 + 462);
+	glDrawArrays(GL_LINES, 0, GRID_POINTS);
+	profiler.end(StageGrid);
 
+	profiler.begin(StageFade);
 	/*Draw deletion animation*/
-	for(vector<vec2>::iterator cell = cellsToAnimate.begin(); cell != cellsToAnimate.end();) {
-		vec4 lerp = getCellColour(*cell);
-		if(lerp.w > 0.01 && !isCellOccupied(*cell)) {
-			setCellColour(*cell, vec4(lerp.x, lerp.y, lerp.z, lerp.w - lerp.w*0.08));
-			cell++;
-		} else
-			cell = cellsToAnimate.erase(cell);
-	}
+	animation.stepFades(*game, boardDirty);
+	updateDrops();
+	profiler.end(StageFade);
+
+	profiler.begin(StageUpload);
 	updateBoard();
-	
+	profiler.end(StageUpload);
+
+	profiler.begin(StageText);
 	// fade out everyhing while fading in the game over text
-	if(gui[TextGG]) {
+	if(game->gui[TextGG]) {
 		// fade in GG text
-		glColor4f(1.0f, 0.0f, 0.0f, 1 - fadeOut);
-		drawText("Game over!", -0.1, 0);
-		drawText("Press R to play again", -0.2, -0.2);
-		// fade board
-		for(int i = 0; i < BOARD_POINTS; i++)
-			boardcolours[i] = boardcolours[i] - vec4(0,0,0,fadeOut*0.04); // Let the empty cells on the board be black
+		text.set(HudGameOver, "Game over!", -0.1, 0, vec4(1, 0, 0, 1 - fadeOut));
+		text.set(HudPlayAgain, "Press R to play again", -0.2, -0.2, vec4(1, 0, 0, 1 - fadeOut));
 		// fade grid
-		vec4 gridcolours[64]; // One colour per vertex
-		for(int i = 0; i < 64; i++)
+		vec4 gridcolours[GRID_FACE_POINTS]; // One colour per vertex
+		for(int i = 0; i < GRID_FACE_POINTS; i++)
 			gridcolours[i] = vec4(gridColour.x,gridColour.y,gridColour.z,fadeOut*0.04);
 		glBindBuffer(GL_ARRAY_BUFFER, vboIDs[GridColourBO]); // Bind the second grid VBO (vertex colours)
-		glBufferData(GL_ARRAY_BUFFER, 64*sizeof(vec4), gridcolours, GL_DYNAMIC_DRAW); // Put the grid colours in the VBO
-		// fade out tile
-		for(int i = 0; i < 4; i++)
-			currTileColours[i] -= vec4(0,0,0, fadeOut*0.04);
+		bufferColours(0, GRID_FACE_POINTS, gridcolours); // Put the grid colours in the VBO
+		// fade out tile, the board is faded by updateBoard()
 		updateTileColours();
 		// decrement fadeOut
 		fadeOut -= fadeOut > 0.01 ?  fadeOut * 0.05 : 0;
+	} else {
+		text.hide(HudGameOver);
+		text.hide(HudPlayAgain);
 	}
 
-
-	glColor4f(0.0f, 0.0f, 0.0f, fadeOut);
-	stringstream ss;
-	// noskipws to draw whitespace 
-	ss << noskipws << "Tile position: " << currTilePos.x << ',' << currTilePos.y;
-	drawText(ss.str(), -1, 0.95);
-
-	drawText("have fun!", x+=0.001, y);
-
-	ss.clear(); ss.str("");
-	ss << noskipws << "Score: " << gui[TextScore] << " Cells Deleted: " << gui[TextCells] << " Rows Deleted: " << gui[TextRows];
-	drawText(ss.str(), -0.5, -0.95);
-
-	ss.clear(); ss.str("");
-	if(gui[GripTime] > 0) {
-		gui[GripTime] -= 1/60.0;
+	updateHudStrings();
+	vec4 hudColour = vec4(0, 0, 0, fadeOut);
+	text.set(HudTilePosition, tilePositionText, -1, 0.95, hudColour);
+	text.set(HudFun, "have fun!", x+=0.001, y, hudColour);
+	text.set(HudScore, scoreText, -0.5, -0.95, hudColour);
+	text.set(HudGripTime, gripTimeText, -0.1, 0.95, hudColour);
+
+	if(showProfile) {
+		if(profileLines.empty() || profiler.frameCount() % PROFILE_HUD_FRAMES == 0) updateProfileLines();
+		for(size_t i = 0; i < profileLines.size(); i++)
+			text.set(HudProfile + i, profileLines[i], -1, 0.85 - 0.05*i, black);
 	} else {
-		// if can't release, move arm to middle and release
-		if(!canRelease()) {
-			robot::Theta[robot::LowerArm] = 5;
-			robot::Theta[robot::UpperArm] = -85;
-			updatetile();
-		}
-		gui[GripTime] = MAX_GRIP_TIME;
-		numFastDropTileCallbacks++;
-		tileDrop(TILE_TICK_FAST);
+		for(int i = HudProfile; i < MaxHudTexts; i++)
+			text.hide(i);
 	}
-	ss << noskipws << "Gripper Time Remaining: " << gui[GripTime];
-	drawText(ss.str(), -0.1, 0.95);
+	text.draw();
+	profiler.end(StageText);
 
-	glutSwapBuffers();
+	profiler.end(StageFrame);
+	profiler.endFrame();
+	// finish every offscreen frame so the frame rate counts all of the rendering, as a swap would
+	if(offscreen) glFinish();
+	else glutSwapBuffers();
 }
 
 // Reshape callback will simply change xsize and ysize variables, which are passed to the vertex shader
@@ -749,6 +745,7 @@ void reshape(GLsizei w, GLsizei h) {
 	xsize = w;
 	ysize = h;
 	glViewport(0, 0, w, h);
+	text.resize(w, h);
 }
 
 // Handle arrow key keypresses
@@ -757,20 +754,14 @@ void special(int key, int x, int y) {
 		case GLUT_KEY_UP:
 			if(glutGetModifiers() == GLUT_ACTIVE_CTRL)
 				View *= RotateZ(10);
-			else {
-				rotateCurrentTile(0);
-				updatetile();
-			}
+			else
+				stepGame(InputRotateTile);
 			break;
 		case GLUT_KEY_DOWN:
 			if(glutGetModifiers() == GLUT_ACTIVE_CTRL)
 				View *= RotateZ(-10);
-			else if(numFastDropTileCallbacks == 0) {
-				if(canRelease()) {
-					numFastDropTileCallbacks++;
-					tileDrop(TILE_TICK_FAST);
-				}
-			}
+			else
+				stepGame(InputFastDrop);
 			break;
 		case GLUT_KEY_RIGHT:
 			if(glutGetModifiers() == GLUT_ACTIVE_CTRL)
@@ -787,19 +778,6 @@ void special(int key, int x, int y) {
 
 // Handles standard keypresses
 void keyboard(unsigned char key, int x, int y) {
-	// various test cases. press t or z to find out!
-	int test[] = {
-		0, 0, ColourApple, 0, 1, ColourApple, 0, 2, ColourGrape, 0, 3, ColourGrape, 0, 4, ColourApple, 0, 5, ColourApple,
-		3, 0, ColourApple, 3, 1, ColourApple,
-		4, 0, ColourApple, 4, 1, ColourApple, 4, 2, ColourGrape,
-		5, 0, ColourGrape, 5, 1, ColourGrape, 5, 2, ColourApple,
-		7, 0, ColourGrape, 7, 1, ColourGrape, 7, 2, ColourApple
-	};
-	int test2[] = {
-		4, 0, ColourApple, 4, 1, ColourGrape, 4, 2, ColourGrape,
-		5, 0, ColourApple, 5, 1, ColourApple, 5, 2, ColourGrape,
-		6, 1, ColourApple
-	};
 	switch(key) 
 	{
 		case 033: // Both escape key and 'q' cause the game to exit
@@ -812,49 +790,38 @@ void keyboard(unsigned char key, int x, int y) {
 			restart();
 			break;
 		case ' ':
-			if(glutGetModifiers() == GLUT_ACTIVE_CTRL) {
-				shuffleAndUpdateColours();
-				updatetile();
-			} else {
-				if(canRelease()) {
-					numDropTileCallbacks++;
-					glutTimerFunc(0, tileDrop, TILE_CREATE);
-				}
-			}
+			if(glutGetModifiers() == GLUT_ACTIVE_CTRL)
+				stepGame(InputShuffleColours);
+			else
+				stepGame(InputReleaseTile);
 			break;
 		case 'a':
-			cout << "theta[lowerArm] = " << robot::Theta[robot::LowerArm] << endl;
-			robot::Theta[robot::LowerArm] += 5;
-			updatetile();
+			cout << "theta[lowerArm] = " << game->arm.getTheta()[robot::LowerArm] << endl;
+			stepGame(InputLowerArmCCW);
 			break;
 		case 'd':
-			cout << "theta[lowerArm] = " << robot::Theta[robot::LowerArm] << endl;
-			robot::Theta[robot::LowerArm] -= 5;
-			updatetile();
+			cout << "theta[lowerArm] = " << game->arm.getTheta()[robot::LowerArm] << endl;
+			stepGame(InputLowerArmCW);
 			break;
 		case 'w':
-			cout << "theta[upperArm] = " << robot::Theta[robot::UpperArm] << endl;
-			robot::Theta[robot::UpperArm] += 5;
-			updatetile();
+			cout << "theta[upperArm] = " << game->arm.getTheta()[robot::UpperArm] << endl;
+			stepGame(InputUpperArmCCW);
 			break;
 		case 's':
-			cout << "theta[upperArm] = " << robot::Theta[robot::UpperArm] << endl;
-			robot::Theta[robot::UpperArm] -= 5;
-			updatetile();
+			cout << "theta[upperArm] = " << game->arm.getTheta()[robot::UpperArm] << endl;
+			stepGame(InputUpperArmCW);
+			break;
+		case 'h': // 'h' hard drops the tile onto its ghost
+			stepGame(InputHardDrop);
+			break;
+		case 'p': // 'p' toggles the frame time HUD
+			showProfile = !showProfile;
 			break;
 		case 't':
-			for(int i = 0; i < (int)sizeof(test)/(int)sizeof(int); i+=3) {
-				cout << '(' << test[i] << ','<< test[i+1] <<") :"<<i<< endl;
-				setCellColour(test[i], test[i+1], fruitColours[test[i+2]]);
-				setCellOccupied(test[i], test[i+1], true);
-			}
+			stepGame(InputTestPattern1);
 			break;
 		case 'z':
-			for(int i = 0; i < (int)sizeof(test2)/(int)sizeof(int); i+=3) {
-				cout << '(' << test2[i] << ','<< test2[i+1] <<") :"<<i<< endl;
-				setCellColour(test2[i], test2[i+1], fruitColours[test2[i+2]]);
-				setCellOccupied(test2[i], test2[i+1], true);
-			}
+			stepGame(InputTestPattern2);
 			break;
 	}
 	glutPostRedisplay();
@@ -864,212 +831,106 @@ void idle(void) {
 	glutPostRedisplay();
 }
 
-// removes the cell at p from the board
-void removeCellFromBoard(const vec2 &p) {
-	gui[TextScore]+=5;
-	gui[TextCells]++;
-	setCellOccupied(p, false);
-	cellsToAnimate.push_back(p);
+void saveProfile() {
+	profiler.save(profileFile);
 }
 
-// fills the appropriate vectors into h and v with the grouped cells
-void recursiveCheck(const vec2 &p, const vec2 &dir, vector<vec2> *h, vector<vec2> *v) {
-	if(dir.x == 0 && dir.y == 0 && isInBoardBounds(p)) {
-		vector<vec2> vertGroup; vertGroup.push_back(vec2(p));
-		vector<vec2> horzGroup; horzGroup.push_back(vec2(p));
-		recursiveCheck(p, vec2(0, -1), NULL, &vertGroup); recursiveCheck(p, vec2(0, 1), NULL, &vertGroup);
-		recursiveCheck(p, vec2(1, 0), &horzGroup, NULL); recursiveCheck(p, vec2(-1, 0), &horzGroup, NULL);
-		// swaps the discoevered cells into h and v
-		h->swap(horzGroup); v->swap(vertGroup);
-	} else {
-		if(isInBoardBounds(p + dir) && isCellOccupied(p + dir) && vec4Equal(getCellColour(p), getCellColour(p + dir))) {
-			if(h) h->push_back(vec2(p + dir)); else v->push_back(vec2(p + dir));
-			recursiveCheck(p + dir, dir, h, v);
-		}
-	}
+void saveReplay() {
+	// marks how long the game went on after the last input
+	game->step(InputNone);
+	replay.save(recordFile);
 }
 
-//-------------------------------------------------------------------------------------------------------------------
-
-// checks for removed cells in removedCells vector and moves the column down if needed, then recursively calls checkGroupedFruits
-// for the shifted cells if needed
-void checkFruitColumn() {
-	// filled in previous iterations
-	static vector<vec2> checkNext;
-	for(vector<vec2>::iterator toCheck = checkNext.begin(); toCheck != checkNext.end();)  {
-		// detect the marker. if the marker is detected, break and check the rest in next time this function is called (next tick)
-		if(toCheck->x == -1 && toCheck->y == -1) {
-			checkNext.erase(toCheck);
-			break; 
-		}
-		gui[TextScore] += 10;
-		printVec2(*toCheck);
-		checkGroupedFruits(*toCheck);
-		toCheck = checkNext.erase(toCheck);
-	} // cout << endl;
-
-	// sort by decreasing Ys to prioritize removal of lower cells first
-	sort(removedCells.begin(), removedCells.end(), sortByDecY());
-	// set used to make sure only one removal is done per tick per each column
-	set<int> columnChecked;
-	for(vector<vec2>::iterator hole = removedCells.begin(); hole != removedCells.end();) {
-		if(columnChecked.insert(hole->x).second) { // successful insertion means this col hasn't been shifted down yet
-			vec2 baseCellToCheck = vec2(hole->x, hole->y - 1);
-			bool checkInNextIter = !isInBoardBounds(baseCellToCheck) || isCellOccupied(baseCellToCheck);
-			// check to make sure we can still go down
-			for(vector<vec2>::iterator h = removedCells.begin(); h != removedCells.end(); h++) {
-				if(h->x == baseCellToCheck.x) {
-					if(h->y == baseCellToCheck.y) {
-						checkInNextIter = true;
-						//cout << " FOUND IT ! " << endl;
-					}
-				} else continue;
-			}
-			for(int y = hole->y; y < BOARD_HEIGHT - 1; y++) {
-				vec2 cellToBeDropped = vec2(hole->x, y + 1);
-				vec2 cellToBeFilled = vec2(hole->x, y);
-				if(isCellOccupied(cellToBeDropped) && !isCellOccupied(cellToBeFilled)) {
-					setCellOccupied(cellToBeDropped, false);
-					setCellOccupied(cellToBeFilled, true);
-					setCellColour(cellToBeFilled, getCellColour(cellToBeDropped));
-					setCellColour(cellToBeDropped, cellFreeColour);
-					// make note to check for grouped fruits in next iteration
-					if(checkInNextIter) checkNext.push_back(cellToBeFilled);
-				}
-			}
-			hole = removedCells.erase(hole);
-		} else hole++;
-	}
-	// push a marker for current list of cells
-	checkNext.push_back(vec2(-1,-1));
-	glutTimerFunc(tileDropSpeed, tileDrop, TILE_COLUMN_CHECK);
+// Re-simulates a recorded game on g, built for the replay's board, and reports how it ended
+template<class Game> void playReplay(const char *filename, const Replay &r, Game &g) {
+	clock_t start = clock();
+	simulate(g, r);
+	double ms = 1000.0*(clock() - start)/CLOCKS_PER_SEC;
+	cout << filename << ": " << r.events.size() << " inputs over " << (r.events.empty() ? 0 : r.events.back().tick) << " ticks"
+		 << " on a " << r.width << "x" << r.height << " board simulated in " << ms << " ms" << endl;
+	cout << "Score: " << g.gui[TextScore] << " Cells Deleted: " << g.gui[TextCells] << " Rows Deleted: " << g.gui[TextRows] << endl;
 }
 
-// checks using recursion for all cells in same column/row that are the same colour of the cell in position p
-void checkGroupedFruits(const vec2 &p) {
-	vector<vec2> group, horzGroup, vertGroup;;
-	recursiveCheck(p, vec2(0, 0), &horzGroup, &vertGroup);
-	cout << p.x << "," << p.y << "         horzGroup.size(): " << horzGroup.size();
-	for(int k = 0; k < (int)horzGroup.size(); k++) cout << "  " << horzGroup[k].x << "," << horzGroup[k].y;
-	cout << "         vertGroup.size(): " << vertGroup.size();
-	for(int k = 0; k < (int)vertGroup.size(); k++) cout << "  " << vertGroup[k].x << "," << vertGroup[k].y; cout << endl;
-
-	horzGroup.size() >= MAX_FRUIT_GROUP ? group.swap(horzGroup) : group.swap(vertGroup);
-
-	for(int k = 0; group.size() >= MAX_FRUIT_GROUP && k < MAX_FRUIT_GROUP; k++) 
-		if(!isCellOccupied(group[k])) { cout << "xxxxx found cell not uccupied" << endl; return; }
-	for(int k = 0; group.size() >= MAX_FRUIT_GROUP && k < MAX_FRUIT_GROUP; k++) {
-		removedCells.push_back(group[k]);
-		removeCellFromBoard(group[k]);
+// Re-simulates a recorded game without a window, on the standard board unrolled if it was played on one
+int playReplay(const char *filename) {
+	Replay r;
+	if(!r.load(filename)) return EXIT_FAILURE;
+	if(r.width == StandardBoardSize::width && r.height == StandardBoardSize::height) {
+		GameState g(r.seed, r.rules);
+		playReplay(filename, r, g);
+	} else {
+		RuntimeGameState g(r.seed, r.rules, RuntimeBoardSize(r.width, r.height));
+		playReplay(filename, r, g);
 	}
-	numCheckFruitColumnCallbacks++;
-	glutTimerFunc(tileDropSpeed, tileDrop, TILE_COLUMN_CHECK);
+	return EXIT_SUCCESS;
 }
 
-// Checks if the specified row (0 is the bottom 19 the top) is full
-// If every cell in the row is occupied, it will clear that cell and everything above it will shift down one row
-int checkFullRow(const vec2 &p) {
-	int rowsRemoved = 0;
-	int columnsHit = 0;
-	for(int i = 0; i < BOARD_WIDTH && isCellOccupied(i, p.y); i++, columnsHit++);
-	if(columnsHit == BOARD_WIDTH) {
-		gui[TextScore] += 50;
-		gui[TextRows]++;
-		rowsRemoved++;
-		for(int x = 0; x < BOARD_WIDTH; x++) {
-			removeCellFromBoard(vec2(x, p.y));
-			for(int y = p.y; y < BOARD_HEIGHT - 1; y++) {
-				vec2 cellToBeDropped = vec2(x, y + 1);
-				vec2 cellToBeFilled = vec2(x, y);
-				if(isCellOccupied(cellToBeDropped)) {
-					setCellOccupied(cellToBeDropped, false);
-					setCellOccupied(cellToBeFilled, true);
-					setCellColour(cellToBeFilled, getCellColour(cellToBeDropped));
-					setCellColour(cellToBeDropped, cellFreeColour);
-				}
-			}
-		}
-		updateBoard();
-	} 
-	return rowsRemoved;
+// seconds on a monotonic clock
+double wallTime() {
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec*1e-9;
 }
 
-//-------------------------------------------------------------------------------------------------------------------
-
-// main loop that handles the moving down of the tile and other game logic
-void tileDrop(int type) {
-	TileInfo value = TILE_TICK;
-	/*cout << "Y: " << type << endl;
-	cout << "numDropTileCallbacks         : " << numDropTileCallbacks << endl;
-	cout << "numFastDropTileCallbacks     : " << numFastDropTileCallbacks << endl;
-	cout << "numCheckFruitColumnCallbacks : " << numCheckFruitColumnCallbacks << endl;*/
-	switch(type) {
-		case TILE_CREATE: // fall-through
-		case TILE_TICK:
-			if(numDropTileCallbacks > 1) { numDropTileCallbacks--; return; }
-			if(numDropTileCallbacks == 1) {
-				if(tileFreeToFall(currTilePos)) {
-					currTilePos.y -= 1;
-					tileFalling = true;
-					updatetile();
-					glutTimerFunc(tileDropSpeed, tileDrop, value);
-				} else {
-					numFastDropTileCallbacks = 0;
-					numDropTileCallbacks--;
-					setTileColour(currTilePos);
-					// disable tile deletion ;)
-					/*
-					vector<vec2> lowestYCellsFirst; 
-					for(int i = 0; i < 4; i++) lowestYCellsFirst.push_back(currTilePos + currTileOffset[i]);
-					sort(lowestYCellsFirst.begin(), lowestYCellsFirst.end(), sortByIncY());
-					int rowOffset = 0;
-					for(int i = 0; i < 4; i++) {
-						rowOffset+=checkFullRow(lowestYCellsFirst[i] - vec2(0, rowOffset));
-						vector<vec2> horzGroup, vertGroup;
-						recursiveCheck(lowestYCellsFirst[i], vec2(0, 0), &horzGroup, &vertGroup);
-						if(horzGroup.size() >= MAX_FRUIT_GROUP) {
-							checkGroupedFruits(lowestYCellsFirst[i]);
-						} else if(i == 3) {
-							for(int k = 0; k < 4; k++) checkGroupedFruits(lowestYCellsFirst[k]);
-						}
-					} */
-					newtile();
-					tileFalling = false;
-				}
-				updateBoard();
-			}	
-			return;
-		case TILE_TICK_FAST:
-			if(numFastDropTileCallbacks > 1) { numFastDropTileCallbacks--; return; }
-			if(numFastDropTileCallbacks == 1) {
-				if(tileFreeToFall(currTilePos)){
-					currTilePos.y -= 1;
-					tileFalling = true;
-					updatetile();
-					glutTimerFunc(TILE_DROP_SPEED_FAST, tileDrop, TILE_TICK_FAST);
-				} else {
-					numDropTileCallbacks++;
-					glutTimerFunc(TILE_DROP_SPEED, tileDrop, TILE_TICK);
-				}
-			}
-			return;
-		case TILE_COLUMN_CHECK:
-			if(numCheckFruitColumnCallbacks > 1) { numCheckFruitColumnCallbacks--; return; }
-			if(numCheckFruitColumnCallbacks == 1)
-				checkFruitColumn();
-			return;
-		default: cout << "WARNING: erroneous call to tileDrop" << endl; return;;
+// Renders frames frames into an offscreen framebuffer while a simple bot plays, releasing every tile as soon
+// as it can, and reports the frame rate. The game runs at 60 frames per second of game time
+int runOffscreen(int frames, uint64_t seed) {
+	offscreen = true;
+	if(!createOffscreenContext(xsize, ysize)) return EXIT_FAILURE;
+	glewInit();
+	game = new GameState(seed);
+	if(recordFile) game->record(&replay);
+	init();
+	profiler.init(GLEW_VERSION_3_3 || GLEW_ARB_timer_query, profileFile != NULL);
+	if(profileFile) atexit(saveProfile);
+
+	double start = wallTime(), ticks = 0;
+	for(int i = 0; i < frames; i++) {
+		for(ticks += 1000.0/60/TICK_MS; ticks >= 1; ticks--)
+			handleStep(game->tick());
+		if(game->gui[TextGG]) restart();
+		else if(!game->tileFalling && game->canRelease()) stepGame(InputReleaseTile);
+		display();
 	}
+	double secs = wallTime() - start;
+	cout << frames << " frames at " << xsize << "x" << ysize << " in " << secs << " s: " << frames/secs << " fps" << endl;
+
+	bool ok = screenshotFile == NULL || saveScreenshot(screenshotFile, xsize, ysize);
+	destroyOffscreenContext();
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+// Usage: FruitTetris [-seed N] [-record FILE] [-replay FILE] [-profile FILE] [-floatvertices]
+//                    [-offscreen FRAMES [-screenshot FILE.ppm]]
 int main(int argc, char **argv) {
+	uint64_t seed = 1;
+	int offscreenFrames = 0;
+	for(int i = 1; i + 1 < argc; i++) {
+		if(!strcmp(argv[i], "-seed")) seed = strtoull(argv[++i], NULL, 10);
+		else if(!strcmp(argv[i], "-record")) recordFile = argv[++i];
+		else if(!strcmp(argv[i], "-profile")) profileFile = argv[++i];
+		else if(!strcmp(argv[i], "-offscreen")) offscreenFrames = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-screenshot")) screenshotFile = argv[++i];
+		else if(!strcmp(argv[i], "-replay")) return playReplay(argv[++i]);
+	}
+	for(int i = 1; i < argc; i++)
+		if(!strcmp(argv[i], "-floatvertices")) vertexLayout = VertexFloat;
+	replay.seed = seed;
+	if(recordFile) atexit(saveReplay);
+	if(offscreenFrames > 0) return runOffscreen(offscreenFrames, seed);
+
 	glutInit(&argc, argv);
 	glutInitDisplayMode(GLUT_MULTISAMPLE | GLUT_DEPTH | GLUT_RGBA | GLUT_DOUBLE);
 	glutInitWindowSize(xsize, ysize);
 	glutInitWindowPosition(680, 178); // Center the game window (well, on a 1920x1080 display)
 	glutCreateWindow("Fruit Tetris");
 	glewInit();
+	game = new GameState(seed);
+	if(recordFile) game->record(&replay);
 	init();
+	// GL 3.3 has timestamp queries
+	profiler.init(GLEW_VERSION_3_3 || GLEW_ARB_timer_query, profileFile != NULL);
+	if(profileFile) atexit(saveProfile);
 
 	// Callback functions
 	glutDisplayFunc(display);
@@ -1077,6 +938,8 @@ int main(int argc, char **argv) {
 	glutSpecialFunc(special);
 	glutKeyboardFunc(keyboard);
 	glutIdleFunc(idle);
+	lastTickTime = glutGet(GLUT_ELAPSED_TIME);
+	glutTimerFunc(TICK_MS, gameClock, 0);
 
 	glutMainLoop(); // Start main loop
 	return 0;
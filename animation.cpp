@@ -0,0 +1,60 @@
+#include <algorithm>
+#include "animation.h"
+
+using namespace std;
+
+BoardAnimation::BoardAnimation() {
+	for(int i = 0; i < Cells; i++)
+		fade[i] = drop[i] = dropRows[i] = dropStart[i] = 0;
+}
+
+void BoardAnimation::clear() {
+	fading.clear();
+	for(int i = 0; i < Cells; i++)
+		fade[i] = dropRows[i] = 0;
+}
+
+// drops of a column come bottom up, so a cell leaves its old cell before another one falls into it; a cell that
+// falls again carries on from wherever it was drawn
+void BoardAnimation::start(const StepResult &r, uint32_t now) {
+	for(size_t i = 0; i < r.removedCells.size(); i++) {
+		fade[Width*r.removedCells[i].y + r.removedCells[i].x] = 1;
+		fading.push_back(r.removedCells[i]);
+	}
+	for(size_t i = 0; i < r.droppedCells.size(); i++) {
+		int to = Width*r.droppedCells[i].to.y + r.droppedCells[i].to.x;
+		int from = to + Width*r.droppedCells[i].rows;
+		if(find(dropping.begin(), dropping.end(), to) == dropping.end())
+			dropping.push_back(to);
+		dropRows[to] = r.droppedCells[i].rows + drop[from];
+		dropStart[to] = now;
+		dropRows[from] = 0;
+		dropStart[from] = now;
+	}
+}
+
+void BoardAnimation::stepFades(const GameState &game, Bitboard &dirty) {
+	for(vector<Cell>::iterator cell = fading.begin(); cell != fading.end();) {
+		float &lerp = fade[Width*cell->y + cell->x];
+		dirty.setOccupied(cell->x, cell->y, true);
+		if(lerp > 0.01 && !game.isCellOccupied(*cell)) {
+			lerp -= lerp*0.08;
+			cell++;
+		} else {
+			lerp = 0;
+			cell = fading.erase(cell);
+		}
+	}
+}
+
+int BoardAnimation::stepDrops(uint32_t now, int *moved) {
+	int n = 0;
+	for(vector<int>::iterator i = dropping.begin(); i != dropping.end();) {
+		float fallen = (now - dropStart[*i])*TICK_MS/(float)TILE_DROP_SPEED;
+		drop[*i] = max(0.0f, dropRows[*i] - fallen);
+		moved[n++] = *i;
+		if(drop[*i] > 0) i++;
+		else i = dropping.erase(i);
+	}
+	return n;
+}
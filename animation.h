@@ -0,0 +1,39 @@
+#ifndef __ANIMATION_H__
+#define __ANIMATION_H__
+
+#include <vector>
+#include "game.h"
+
+// Front end animations of cells the game is already done with: removed cells fading out and the cells of collapsed
+// columns falling into place. One per game on screen, no GL in here
+class BoardAnimation {
+public:
+	// the front end draws the standard board, so the cells are in arrays sized at compile time, row by row
+	enum { Width = StandardBoardSize::width, Cells = StandardBoardSize::width*StandardBoardSize::height };
+
+	// alpha of each cell while it fades out after being removed, 0 when the cell is not fading
+	float fade[Cells];
+	// rows above its cell each cell is drawn at while it falls
+	GLfloat drop[Cells];
+
+	BoardAnimation();
+
+	// stops every animation; cells still drawn above their cell are put back by the next stepDrops()
+	void clear();
+	// starts animating what changed in a step or tick of the game at game tick now
+	void start(const StepResult &r, uint32_t now);
+	// fades removed cells one frame further, marking the cells whose colour changed in dirty
+	void stepFades(const GameState &game, Bitboard &dirty);
+	// moves falling cells to where they are at game tick now, one row per TILE_DROP_SPEED ms; writes the index of
+	// every cell whose drop changed into moved and returns how many there are
+	int stepDrops(uint32_t now, int *moved);
+
+private:
+	std::vector<Cell> fading;
+	std::vector<int> dropping;
+	// each falling cell falls from dropRows at tick dropStart
+	float dropRows[Cells];
+	uint32_t dropStart[Cells];
+};
+
+#endif // __ANIMATION_H__
@@ -0,0 +1,184 @@
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "arm.h"
+#include "tiles.h"
+
+namespace robot {
+
+// the tip rounds to cells with this pi; some poses land right between two cells, and which one they pick is part of
+// the game (and its replays)
+const double TIP_PI = 3.14159;
+// the tip is half a unit short of the end of the upper arm
+const GLfloat TIP_LENGTH = UPPER_ARM_HEIGHT - 0.5;
+
+// Sums in double, so that a tip half a cell from two cells rounds the same way wherever this is inlined
+Cell getTip(const ArmGeometry &geometry, const GLfloat *theta) {
+	double s = geometry.scale;
+	// base
+	double x = geometry.pos.x/2;
+	double y = geometry.pos.y + s*BASE_HEIGHT;
+	// lower arm
+	x += s*LOWER_ARM_HEIGHT * -sin(TIP_PI/180* theta[LowerArm]);
+	y += s*LOWER_ARM_HEIGHT * cos(-TIP_PI/180* theta[LowerArm]);
+	// upper arm
+	x += s*TIP_LENGTH * -cos(TIP_PI/180* (90 - theta[LowerArm] - theta[UpperArm]));
+	y += s*TIP_LENGTH * sin(TIP_PI/180* (90 - theta[LowerArm] - theta[UpperArm]));
+	// round to the cell
+	return Cell((int)(0.5 + x), (int)(0.5 + y));
+}
+
+// Both arms turn counterclockwise from pointing up, so an arm at angle a points along (-sin a, cos a). The law of
+// cosines on the triangle of the shoulder, elbow and target gives the elbow angle, and the lower arm is turned
+// towards the target less the angle the bent elbow puts between the lower arm and the target
+bool solveTip(const ArmGeometry &geometry, const vec2 &target, bool elbowCW, GLfloat &lower, GLfloat &upper) {
+	double s = geometry.scale;
+	double dx = target.x - geometry.pos.x/2, dy = target.y - (geometry.pos.y + s*BASE_HEIGHT);
+	double l1 = s*LOWER_ARM_HEIGHT, l2 = s*TIP_LENGTH;
+	double c = (dx*dx + dy*dy - l1*l1 - l2*l2)/(2*l1*l2);
+	if(c < -1 || c > 1) return false;
+	double elbow = elbowCW ? -acos(c) : acos(c);
+	double shoulder = atan2(-dx, dy) - atan2(l2*sin(elbow), l1 + l2*cos(elbow));
+	lower = shoulder*180/M_PI;
+	upper = elbow*180/M_PI;
+	return true;
+}
+
+bool aimTip(const ArmGeometry &geometry, const Cell &target, const GLfloat *theta, GLfloat *aim) {
+	int bestSteps = -1;
+	for(int elbowCW = 0; elbowCW < 2; elbowCW++) {
+		GLfloat solved[NumAngles];
+		if(!solveTip(geometry, vec2(target.x, target.y), elbowCW, solved[LowerArm], solved[UpperArm])) continue;
+		// the solution is off the joint step grid, so try the steps on either side of it
+		int first[NumAngles];
+		for(int j = LowerArm; j <= UpperArm; j++) {
+			GLfloat delta = solved[j] - theta[j];
+			delta -= 360*floor((delta + 180)/360);
+			first[j] = (int)floor(delta/geometry.jointStep) - 1;
+		}
+		GLfloat t[NumAngles];
+		t[Base] = theta[Base];
+		for(int l = first[LowerArm]; l <= first[LowerArm] + 3; l++) {
+			for(int u = first[UpperArm]; u <= first[UpperArm] + 3; u++) {
+				int steps = abs(l) + abs(u);
+				if(bestSteps >= 0 && steps >= bestSteps) continue;
+				t[LowerArm] = theta[LowerArm] + l*geometry.jointStep;
+				t[UpperArm] = theta[UpperArm] + u*geometry.jointStep;
+				if(getTip(geometry, t) != target) continue;
+				bestSteps = steps;
+				for(int j = 0; j < NumAngles; j++) aim[j] = t[j];
+			}
+		}
+	}
+	return bestSteps >= 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// whether the tip of the arm can be steered over every cell of a board of width by height
+static bool reachesBoard(const ArmGeometry &geometry, int width, int height) {
+	bool reached[MAX_BOARD_WIDTH*MAX_BOARD_HEIGHT] = {};
+	forEachPose(geometry, [&](const GLfloat *theta) {
+		Cell tip = getTip(geometry, theta);
+		if(tip.x >= 0 && tip.x < width && tip.y >= 0 && tip.y < height) reached[tip.y*width + tip.x] = true;
+	});
+	for(int i = 0; i < width*height; i++)
+		if(!reached[i]) return false;
+	return true;
+}
+
+// The standard arm grown (or shrunk) with the board, and grown a percent at a time further until the far corner is
+// comfortably within reach; the shoulder stands to the left of the board, so that corner is the top right one for
+// the tall boards and the bottom right one for the wide ones. Joint steps are as fine on the board as the standard
+// arm's, halving until the tip can be steered over every cell. The home pose puts the tip over the middle of the
+// board, four rows from the top like the standard arm's but never so low that a tile hangs below the floor, on the
+// joint step grid of the standard home pose
+static ArmGeometry fitBoard(int width, int height) {
+	ArmGeometry g;
+	double s = std::max(width/(double)StandardBoardSize::width, height/(double)StandardBoardSize::height);
+	double reach = LOWER_ARM_HEIGHT + TIP_LENGTH;
+	for(;;) {
+		double dx = width - 1 - s*BASE_POSITION.x/2;
+		double dy = std::max(fabs(height - 1 - s*BASE_HEIGHT), s*BASE_HEIGHT);
+		if(hypot(dx, dy) <= 0.99*s*reach) break;
+		s *= 1.01;
+	}
+	g.scale = s;
+	g.pos = s*BASE_POSITION;
+	int steps = (int)ceil(s*360/JOINT_STEP);
+	for(int tries = 0; tries < 4; tries++, steps *= 2) {
+		g.jointStep = 360.0/steps;
+		if(reachesBoard(g, width, height)) break;
+	}
+	GLfloat standard[NumAngles] = {0, HOME_LOWER, HOME_UPPER}, home[NumAngles];
+	if(aimTip(g, Cell(width/2 - 1, std::max(height - 4, TILE_REACH)), standard, home)) {
+		g.homeLower = home[LowerArm];
+		g.homeUpper = home[UpperArm];
+	}
+	return g;
+}
+
+const ArmGeometry &armGeometry(int width, int height) {
+	static const ArmGeometry standard;
+	if(width == StandardBoardSize::width && height == StandardBoardSize::height) return standard;
+	static thread_local ArmGeometry last;
+	static thread_local int lastWidth = 0, lastHeight = 0;
+	if(width != lastWidth || height != lastHeight) {
+		last = fitBoard(width, height);
+		lastWidth = width;
+		lastHeight = height;
+	}
+	return last;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+Arm::Arm() {
+	reset(ArmGeometry());
+	setAngles(0, 0);
+}
+
+void Arm::reset(const ArmGeometry &g) {
+	geometry = g;
+	theta[Base] = 0;
+	theta[LowerArm] = geometry.homeLower;
+	theta[UpperArm] = geometry.homeUpper;
+	tip = robot::getTip(geometry, theta);
+	partsValid = false;
+}
+
+void Arm::turn(int joint, GLfloat degrees) {
+	theta[joint] += degrees;
+	tip = robot::getTip(geometry, theta);
+	partsValid = false;
+}
+
+void Arm::setAngles(GLfloat lower, GLfloat upper) {
+	theta[LowerArm] = lower;
+	theta[UpperArm] = upper;
+	tip = robot::getTip(geometry, theta);
+	partsValid = false;
+}
+
+// the unit cube scaled to a part of width by height, standing on the origin
+static mat4 partShape(GLfloat width, GLfloat height) {
+	return Translate(0.0, 0.5*height, 0.0) * Scale(width, height, width);
+}
+
+const mat4 *Arm::getPartTransforms() const {
+	if(partsValid) return parts;
+	// each part hangs off the top of the one before it
+	GLfloat s = geometry.scale;
+	mat4 m = Translate(geometry.pos) * RotateY(theta[Base]);
+	parts[Base] = m * partShape(s*BASE_WIDTH, s*BASE_HEIGHT);
+
+	m *= Translate(0.0, s*BASE_HEIGHT, 0.0);
+	m *= RotateZ(theta[LowerArm]);
+	parts[LowerArm] = m * partShape(s*LOWER_ARM_WIDTH, s*LOWER_ARM_HEIGHT);
+
+	m *= Translate(0.0, s*LOWER_ARM_HEIGHT, 0.0);
+	m *= RotateZ(theta[UpperArm]);
+	parts[UpperArm] = m * partShape(s*UPPER_ARM_WIDTH, s*UPPER_ARM_HEIGHT);
+	partsValid = true;
+	return parts;
+}
+
+} // namespace robot
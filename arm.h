@@ -0,0 +1,101 @@
+#ifndef __ARM_H__
+#define __ARM_H__
+
+#include "include/Angel.h"
+#include "cell.h"
+
+// Robot arm dimensions and kinematics, shared by the game logic and the robot renderer
+namespace robot {
+
+// Parameters controlling the size of the Robot's arm
+const GLfloat BASE_HEIGHT      = 2.0;
+const GLfloat BASE_WIDTH       = 5.0;
+const GLfloat LOWER_ARM_HEIGHT = 12.0;
+const GLfloat LOWER_ARM_WIDTH  = 0.5;
+const GLfloat UPPER_ARM_HEIGHT = 11.0;
+const GLfloat UPPER_ARM_WIDTH  = 0.5;
+enum { Base = 0, LowerArm = 1, UpperArm = 2, NumAngles = 3 };
+// where the base of the arm stands, and how many degrees a joint turns per input
+const vec3 BASE_POSITION = vec3(-10, 0, 0);
+const GLfloat JOINT_STEP = 5;
+// joint angles of the lower and upper arm each game starts with, holding the tile over the middle of the board
+const GLfloat HOME_LOWER = 5;
+const GLfloat HOME_UPPER = -85;
+
+// The size and stance of an arm. The standard arm, made of the constants above, is the one for the standard board;
+// the arm for any other board is the standard one scaled until its tip reaches the far corner, turning its joints
+// in steps fine enough that the tip can be steered over every cell
+struct ArmGeometry {
+	vec3 pos; // where the base stands
+	GLfloat scale; // of every length of the standard arm
+	GLfloat jointStep; // degrees a joint turns per input, a whole number of them to the turn
+	GLfloat homeLower, homeUpper; // joint angles each game starts with, holding the tile over the middle of the board
+
+	// the standard arm
+	ArmGeometry()
+		: pos(BASE_POSITION), scale(1), jointStep(JOINT_STEP), homeLower(HOME_LOWER), homeUpper(HOME_UPPER) {}
+};
+
+// The arm for a board of width by height cells. Working it out sweeps every pose of a few candidate arms, so each
+// thread keeps the last one it worked out
+const ArmGeometry &armGeometry(int width, int height);
+
+// Calls f(theta) with every pose of the lower and upper arm a whole number of joint steps from the home pose, each
+// angle taken in [0, 360)
+template<class F> void forEachPose(const ArmGeometry &geometry, F f) {
+	int steps = (int)(0.5 + 360/geometry.jointStep);
+	GLfloat theta[NumAngles] = {0, 0, 0};
+	for(int lower = 0; lower < steps; lower++) {
+		for(int upper = 0; upper < steps; upper++) {
+			theta[LowerArm] = geometry.homeLower + lower*geometry.jointStep;
+			theta[UpperArm] = geometry.homeUpper + upper*geometry.jointStep;
+			for(int j = LowerArm; j <= UpperArm; j++) theta[j] -= 360*floor(theta[j]/360);
+			f(theta);
+		}
+	}
+}
+
+// grid cell under the tip of the arm with joint angles theta (in degrees)
+Cell getTip(const ArmGeometry &geometry, const GLfloat *theta);
+
+// Angles of the lower and upper arm (in degrees) that put the tip of the arm right on point target, worked out in
+// closed form from the triangle of the two arms; the elbow bends clockwise or counterclockwise. False if target is
+// out of reach
+bool solveTip(const ArmGeometry &geometry, const vec2 &target, bool elbowCW, GLfloat &lower, GLfloat &upper);
+// Joint angles a whole number of joint steps away from theta that put the tip in cell target, with as few steps as
+// either elbow needs; false if there are none near the solveTip() solutions. Angles are taken the short way round
+bool aimTip(const ArmGeometry &geometry, const Cell &target, const GLfloat *theta, GLfloat *aim);
+
+//-------------------------------------------------------------------------------------------------------------------
+// The pose of an arm and what follows from it: the tip is worked out again whenever a joint turns, the transforms
+// of its parts only when the renderer asks for them after a turn
+class Arm {
+public:
+	Arm();
+
+	// makes this the arm of geometry, in its home pose with the base unturned
+	void reset(const ArmGeometry &geometry);
+	// turns joint by degrees
+	void turn(int joint, GLfloat degrees);
+	// poses the lower and upper arm at lower and upper degrees
+	void setAngles(GLfloat lower, GLfloat upper);
+
+	const ArmGeometry &getGeometry() const { return geometry; }
+	// joint angles in degrees
+	const GLfloat *getTheta() const { return theta; }
+	const Cell &getTip() const { return tip; }
+	// model transforms of the base, lower arm and upper arm, each taking the unit cube centred on the origin to the
+	// part
+	const mat4 *getPartTransforms() const;
+
+private:
+	ArmGeometry geometry;
+	GLfloat theta[NumAngles];
+	Cell tip;
+	mutable mat4 parts[NumAngles];
+	mutable bool partsValid;
+};
+
+} // namespace robot
+
+#endif // __ARM_H__
@@ -0,0 +1,129 @@
+#ifndef __BITBOARD_H__
+#define __BITBOARD_H__
+
+#include <algorithm>
+#include <stdint.h>
+#include "include/Angel.h"
+#include "cell.h"
+
+// One machine word per row, bit x of rows[y] is set if cell (x,y) is occupied
+typedef unsigned int BoardRow;
+const int BOARD_ROW_BITS = 8*sizeof(BoardRow);
+// A set of rows of the board, bit y for row y
+typedef uint64_t RowMask;
+
+// largest board a RuntimeBoardSize can have
+#define MAX_BOARD_WIDTH 32
+#define MAX_BOARD_HEIGHT 48
+
+//-------------------------------------------------------------------------------------------------------------------
+// Sizes a board can be built with, read the same way by the board and game templates: size.width and size.height,
+// with maxWidth and maxHeight to size arrays by. A FixedBoardSize is known at compile time, so every loop over its
+// board has constant bounds
+template<int W, int H> struct FixedBoardSize {
+	static constexpr int width = W, height = H;
+	static constexpr int maxWidth = W, maxHeight = H;
+};
+
+// A board size picked at run time, up to MAX_BOARD_WIDTH by MAX_BOARD_HEIGHT
+struct RuntimeBoardSize {
+	int width, height;
+	static constexpr int maxWidth = MAX_BOARD_WIDTH, maxHeight = MAX_BOARD_HEIGHT;
+
+	RuntimeBoardSize(int width = 10, int height = 20) : width(width), height(height) {}
+};
+
+// the board FruitTetris is played on
+typedef FixedBoardSize<10, 20> StandardBoardSize;
+
+static_assert(MAX_BOARD_WIDTH <= BOARD_ROW_BITS, "a row of the board fits in a BoardRow");
+static_assert(MAX_BOARD_HEIGHT <= 8*sizeof(RowMask), "the rows of the board fit in a RowMask");
+
+// shifts a row mask left by s bits (right if s is negative); bits shifted past the word are dropped
+inline BoardRow shiftRow(BoardRow m, int s) {
+	if(s >= 0) return s < BOARD_ROW_BITS ? m << s : 0;
+	return -s < BOARD_ROW_BITS ? m >> -s : 0;
+}
+
+// index of the lowest set bit of m, which must not be 0
+inline int lowestBit(uint64_t m) {
+#ifdef __GNUC__
+	return __builtin_ctzll(m);
+#else
+	int i = 0;
+	while(!(m >> i & 1)) i++;
+	return i;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// Row masks of the 4 cells of a tile, so a tile can be tested against the board with a shift and an AND per row
+struct TileFootprint {
+	int minX, maxX; // horizontal extent of the offsets
+	int minY, maxY; // vertical extent of the offsets
+	BoardRow rows[4]; // rows[i] is the mask of offset row minY + i, bit 0 being offset column minX
+	int bottom[4]; // bottom[i] is the lowest offset y in offset column minX + i
+
+	constexpr void set(const Cell *offsets) {
+		minX = maxX = offsets[0].x;
+		minY = maxY = offsets[0].y;
+		for(int i = 1; i < 4; i++) {
+			minX = std::min(minX, offsets[i].x); maxX = std::max(maxX, offsets[i].x);
+			minY = std::min(minY, offsets[i].y); maxY = std::max(maxY, offsets[i].y);
+		}
+		for(int i = 0; i < 4; i++) { rows[i] = 0; bottom[i] = maxY; }
+		for(int i = 0; i < 4; i++) {
+			rows[offsets[i].y - minY] |= 1u << (offsets[i].x - minX);
+			bottom[offsets[i].x - minX] = std::min(bottom[offsets[i].x - minX], offsets[i].y);
+		}
+	}
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+template<class Size> struct BasicBitboard {
+	Size size;
+	BoardRow rows[Size::maxHeight];
+
+	BasicBitboard(const Size &size = Size()) : size(size) {}
+
+	// the mask of a row with every cell occupied
+	BoardRow fullRow() const {
+		return (BoardRow)((1ull << size.width) - 1);
+	}
+	void clear() {
+		for(int y = 0; y < size.height; y++) rows[y] = 0;
+	}
+	void fill() {
+		for(int y = 0; y < size.height; y++) rows[y] = fullRow();
+	}
+	// cells outside of the board are never occupied
+	bool isOccupied(int x, int y) const {
+		if(x < 0 || x > size.width - 1 || y < 0 || y > size.height - 1) return false;
+		return (rows[y] >> x) & 1;
+	}
+	void setOccupied(int x, int y, bool o) {
+		if(o) rows[y] |= 1u << x;
+		else  rows[y] &= ~(1u << x);
+	}
+	bool isRowFull(int y) const {
+		return rows[y] == fullRow();
+	}
+
+	// true if the tile with its center at (x,y) lies within the board's columns
+	bool fitsColumns(const TileFootprint &f, int x) const {
+		return x + f.minX >= 0 && x + f.maxX <= size.width - 1;
+	}
+	// true if any cell of the tile with its center at (x,y) is on an occupied cell;
+	// cells of the tile outside of the board are ignored
+	bool overlaps(const TileFootprint &f, int x, int y) const {
+		int shift = x + f.minX;
+		int lo = std::max(0, y + f.minY), hi = std::min(size.height - 1, y + f.maxY);
+		for(int row = lo; row <= hi; row++)
+			if(rows[row] & shiftRow(f.rows[row - y - f.minY], shift)) return true;
+		return false;
+	}
+};
+
+typedef BasicBitboard<StandardBoardSize> Bitboard;
+
+#endif // __BITBOARD_H__
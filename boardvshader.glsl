@@ -0,0 +1,21 @@
+#version 130
+
+// one unit cube, drawn once per board cell
+in vec4 vPosition;
+// per instance: index of the cell on the board, row by row, its colour, and how many rows above its cell it is
+// drawn while falling
+in uint vCell;
+in vec4 vColor;
+in float vDrop;
+out vec4 color;
+
+uniform mat4 MVP;
+uniform uint boardWidth;
+
+void main() 
+{
+	vec2 cell = vec2(vCell % boardWidth, float(vCell / boardWidth) + vDrop);
+	gl_Position = MVP * (vPosition + vec4(33.0*cell, 0.0, 0.0));
+
+	color = vColor;	
+} 
@@ -0,0 +1,22 @@
+#ifndef __CELL_H__
+#define __CELL_H__
+
+// A cell of the board in whole cells ((0,0) is the bottom left corner), or an offset between two cells
+struct Cell {
+	int x, y;
+
+	constexpr Cell() : x(0), y(0) {}
+	constexpr Cell(int x, int y) : x(x), y(y) {}
+
+	constexpr Cell operator+(const Cell &c) const { return Cell(x + c.x, y + c.y); }
+	constexpr Cell operator-(const Cell &c) const { return Cell(x - c.x, y - c.y); }
+	Cell &operator+=(const Cell &c) { x += c.x; y += c.y; return *this; }
+	Cell &operator-=(const Cell &c) { x -= c.x; y -= c.y; return *this; }
+	constexpr bool operator==(const Cell &c) const { return x == c.x && y == c.y; }
+	constexpr bool operator!=(const Cell &c) const { return !(*this == c); }
+
+	// the offset turned a quarter turn clockwise
+	constexpr Cell rotated() const { return Cell(y, -x); }
+};
+
+#endif // __CELL_H__
@@ -0,0 +1,101 @@
+#include "font.h"
+
+// -adobe-helvetica-medium-r-normal--18-180-75-75-p-98-iso8859-1, the X11 font behind GLUT_BITMAP_HELVETICA_18,
+// so the HUD looks the same as it did with glutBitmapCharacter
+const FontGlyph fontGlyphs[FONT_CHARS] = {
+	{ 5, {0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // ' '
+	{ 6, {0x0,0x0,0x0,0x0,0x0,0xc,0xc,0x0,0x0,0x4,0x4,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0x0,0x0,0x0,0x0}}, // '!'
+	{ 5, {0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x9,0x9,0x1b,0x1b,0x1b,0x0,0x0,0x0,0x0}}, // '"'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x24,0x24,0x24,0x1ff,0x1ff,0x48,0x48,0x48,0x3fe,0x3fe,0x90,0x90,0x90,0x0,0x0,0x0,0x0,0x0}}, // '#'
+	{10, {0x0,0x0,0x0,0x20,0x20,0xf8,0x1fc,0x3ae,0x326,0x320,0x1e0,0xf8,0x3c,0x2e,0x26,0x1a6,0x1fc,0xf8,0x20,0x0,0x0,0x0,0x0}}, // '$'
+	{16, {0x0,0x0,0x0,0x0,0x0,0x3c30,0x7e30,0x6660,0x6660,0x7ec0,0x3cc0,0x180,0x1bc,0x37e,0x366,0x666,0x67e,0xc3c,0x0,0x0,0x0,0x0,0x0}}, // '%'
+	{13, {0x0,0x0,0x0,0x0,0x0,0x1c78,0xefc,0x7ce,0x386,0x786,0x6c6,0x6ee,0x7c,0x78,0xcc,0xcc,0xfc,0x78,0x0,0x0,0x0,0x0,0x0}}, // '&'
+	{ 4, {0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x2,0x4,0x4,0x6,0x6,0x0,0x0,0x0,0x0}}, // '\''
+	{ 6, {0x0,0x10,0x18,0xc,0xc,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0xc,0xc,0x18,0x10,0x0,0x0,0x0,0x0}}, // '('
+	{ 6, {0x0,0x2,0x6,0xc,0xc,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0xc,0xc,0x6,0x2,0x0,0x0,0x0,0x0}}, // ')'
+	{ 7, {0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x22,0x1c,0x1c,0x3e,0x8,0x8,0x0,0x0,0x0,0x0}}, // '*'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x30,0x30,0x30,0x30,0x1fe,0x1fe,0x30,0x30,0x30,0x30,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // '+'
+	{ 5, {0x0,0x0,0x2,0x4,0x4,0x6,0x6,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // ','
+	{11, {0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x1fe,0x1fe,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // '-'
+	{ 5, {0x0,0x0,0x0,0x0,0x0,0x6,0x6,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // '.'
+	{ 5, {0x0,0x0,0x0,0x0,0x0,0x3,0x3,0x2,0x2,0x6,0x6,0x4,0x4,0xc,0xc,0x8,0x8,0x18,0x18,0x0,0x0,0x0,0x0}}, // '/'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x78,0xfc,0xcc,0x186,0x186,0x186,0x186,0x186,0x186,0x186,0xcc,0xfc,0x78,0x0,0x0,0x0,0x0,0x0}}, // '0'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x7c,0x7c,0x60,0x0,0x0,0x0,0x0,0x0}}, // '1'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x1fe,0x1fe,0x6,0xe,0x1c,0x38,0x70,0xe0,0x1c0,0x180,0x186,0xfe,0x78,0x0,0x0,0x0,0x0,0x0}}, // '2'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x78,0xfc,0x1c6,0x186,0x180,0x1c0,0xf0,0x70,0xc0,0x186,0x186,0xfc,0x78,0x0,0x0,0x0,0x0,0x0}}, // '3'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x180,0x180,0x180,0x3fe,0x3fe,0x186,0x18c,0x198,0x198,0x1b0,0x1e0,0x1c0,0x180,0x0,0x0,0x0,0x0,0x0}}, // '4'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x7c,0xfe,0x1c6,0x186,0x180,0x180,0x1c6,0xfe,0x7e,0x6,0x6,0xfe,0xfe,0x0,0x0,0x0,0x0,0x0}}, // '5'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x78,0xfc,0x18e,0x186,0x186,0x186,0xfe,0x76,0x6,0x6,0x18c,0x1fc,0x78,0x0,0x0,0x0,0x0,0x0}}, // '6'
+	{10, {0x0,0x0,0x0,0x0,0x0,0xc,0xc,0x18,0x18,0x18,0x30,0x30,0x60,0x60,0xc0,0x180,0x1fe,0x1fe,0x0,0x0,0x0,0x0,0x0}}, // '7'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x78,0xfc,0x1ce,0x186,0x186,0xcc,0xfc,0xcc,0x186,0x186,0x1ce,0xfc,0x78,0x0,0x0,0x0,0x0,0x0}}, // '8'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x7c,0xfe,0xc6,0x180,0x180,0x1b8,0x1fc,0x186,0x186,0x186,0x1c6,0xfc,0x78,0x0,0x0,0x0,0x0,0x0}}, // '9'
+	{ 5, {0x0,0x0,0x0,0x0,0x0,0x6,0x6,0x0,0x0,0x0,0x0,0x0,0x0,0x6,0x6,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // ':'
+	{ 5, {0x0,0x0,0x2,0x4,0x4,0x6,0x6,0x0,0x0,0x0,0x0,0x0,0x0,0x6,0x6,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // ';'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x180,0x1e0,0x78,0x1c,0x6,0x1c,0x78,0x1e0,0x180,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // '<'
+	{11, {0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x1fc,0x1fc,0x0,0x0,0x1fc,0x1fc,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // '='
+	{10, {0x0,0x0,0x0,0x0,0x0,0x6,0x1e,0x78,0xe0,0x180,0xe0,0x78,0x1e,0x6,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // '>'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x18,0x18,0x0,0x0,0x18,0x18,0x18,0x38,0x70,0xe0,0xc6,0xc6,0xfe,0x7c,0x0,0x0,0x0,0x0}}, // '?'
+	{18, {0x0,0x0,0xfc0,0x1ff0,0x38,0x1c,0x1dcc,0x3fe6,0x6666,0xcc66,0xcc66,0x18c66,0x198c6,0x19dcc,0x19b8c,0xc018,0xe070,0x7fe0,0x1f80,0x0,0x0,0x0,0x0}}, // '@'
+	{12, {0x0,0x0,0x0,0x0,0x0,0xc03,0xc03,0x606,0x606,0x7fe,0x3fc,0x30c,0x30c,0x198,0x198,0xf0,0xf0,0x60,0x60,0x0,0x0,0x0,0x0}}, // 'A'
+	{13, {0x0,0x0,0x0,0x0,0x0,0x3fe,0x7fe,0xe06,0xc06,0xc06,0xe06,0x7fe,0x3fe,0x306,0x606,0x606,0x706,0x3fe,0x1fe,0x0,0x0,0x0,0x0}}, // 'B'
+	{14, {0x0,0x0,0x0,0x0,0x0,0x3e0,0xff8,0x1c1c,0x180c,0xe,0x6,0x6,0x6,0x6,0xe,0x180c,0x1c1c,0xff8,0x3e0,0x0,0x0,0x0,0x0}}, // 'C'
+	{13, {0x0,0x0,0x0,0x0,0x0,0x1fe,0x3fe,0x706,0x606,0xc06,0xc06,0xc06,0xc06,0xc06,0xc06,0x606,0x706,0x3fe,0x1fe,0x0,0x0,0x0,0x0}}, // 'D'
+	{11, {0x0,0x0,0x0,0x0,0x0,0x3fe,0x3fe,0x6,0x6,0x6,0x6,0x1fe,0x1fe,0x6,0x6,0x6,0x6,0x3fe,0x3fe,0x0,0x0,0x0,0x0}}, // 'E'
+	{11, {0x0,0x0,0x0,0x0,0x0,0x6,0x6,0x6,0x6,0x6,0x6,0x1fe,0x1fe,0x6,0x6,0x6,0x6,0x3fe,0x3fe,0x0,0x0,0x0,0x0}}, // 'F'
+	{14, {0x0,0x0,0x0,0x0,0x0,0x1be0,0x1ff8,0x1c1c,0x180c,0x180e,0x1f06,0x1f06,0x6,0x6,0x180e,0x180c,0x1c1c,0xff8,0x3e0,0x0,0x0,0x0,0x0}}, // 'G'
+	{13, {0x0,0x0,0x0,0x0,0x0,0xc06,0xc06,0xc06,0xc06,0xc06,0xc06,0xffe,0xffe,0xc06,0xc06,0xc06,0xc06,0xc06,0xc06,0x0,0x0,0x0,0x0}}, // 'H'
+	{ 6, {0x0,0x0,0x0,0x0,0x0,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0x0,0x0,0x0,0x0}}, // 'I'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x78,0xfc,0x1ce,0x186,0x186,0x180,0x180,0x180,0x180,0x180,0x180,0x180,0x180,0x180,0x0,0x0,0x0,0x0}}, // 'J'
+	{13, {0x0,0x0,0x0,0x0,0x0,0x1c06,0xe06,0x706,0x386,0x1c6,0xe6,0x7e,0x3e,0x76,0xe6,0x1c6,0x386,0x706,0xe06,0x0,0x0,0x0,0x0}}, // 'K'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x1fe,0x1fe,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x0,0x0,0x0,0x0}}, // 'L'
+	{16, {0x0,0x0,0x0,0x0,0x0,0x6186,0x6186,0x63c6,0x6246,0x6666,0x6666,0x6c36,0x6c36,0x781e,0x781e,0x700e,0x700e,0x6006,0x6006,0x0,0x0,0x0,0x0}}, // 'M'
+	{13, {0x0,0x0,0x0,0x0,0x0,0xc06,0xe06,0xf06,0xf06,0xd86,0xcc6,0xcc6,0xc66,0xc66,0xc36,0xc1e,0xc1e,0xc0e,0xc06,0x0,0x0,0x0,0x0}}, // 'N'
+	{15, {0x0,0x0,0x0,0x0,0x0,0x3e0,0xff8,0x1c1c,0x180c,0x380e,0x3006,0x3006,0x3006,0x3006,0x380e,0x180c,0x1c1c,0xff8,0x3e0,0x0,0x0,0x0,0x0}}, // 'O'
+	{12, {0x0,0x0,0x0,0x0,0x0,0x6,0x6,0x6,0x6,0x6,0x6,0x1fe,0x3fe,0x706,0x606,0x606,0x706,0x3fe,0x1fe,0x0,0x0,0x0,0x0}}, // 'P'
+	{15, {0x0,0x0,0x0,0x0,0x1800,0x1be0,0xff8,0x1e1c,0x1b0c,0x3b0e,0x3006,0x3006,0x3006,0x3006,0x380e,0x180c,0x1c1c,0xff8,0x3e0,0x0,0x0,0x0,0x0}}, // 'Q'
+	{12, {0x0,0x0,0x0,0x0,0x0,0x606,0x606,0x606,0x606,0x306,0x306,0x1fe,0x3fe,0x706,0x606,0x606,0x706,0x3fe,0x1fe,0x0,0x0,0x0,0x0}}, // 'R'
+	{13, {0x0,0x0,0x0,0x0,0x0,0x1f8,0x7fc,0xe0e,0xc06,0xc00,0xe00,0x780,0x1f0,0x7c,0xe,0xc06,0xe0e,0x7fc,0x1f0,0x0,0x0,0x0,0x0}}, // 'S'
+	{12, {0x0,0x0,0x0,0x0,0x0,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x7fe,0x7fe,0x0,0x0,0x0,0x0}}, // 'T'
+	{13, {0x0,0x0,0x0,0x0,0x0,0x1f0,0x7fc,0x60c,0xc06,0xc06,0xc06,0xc06,0xc06,0xc06,0xc06,0xc06,0xc06,0xc06,0xc06,0x0,0x0,0x0,0x0}}, // 'U'
+	{14, {0x0,0x0,0x0,0x0,0x0,0xc0,0x1e0,0x1e0,0x330,0x330,0x330,0x618,0x618,0x618,0xc0c,0xc0c,0xc0c,0x1806,0x1806,0x0,0x0,0x0,0x0}}, // 'V'
+	{18, {0x0,0x0,0x0,0x0,0x0,0x3030,0x3030,0x3870,0x6858,0x6cd8,0x6cd8,0xcccc,0xcccc,0xc48c,0xc78c,0x18786,0x18306,0x18306,0x18306,0x0,0x0,0x0,0x0}}, // 'W'
+	{13, {0x0,0x0,0x0,0x0,0x0,0xc06,0xe0e,0x60c,0x71c,0x318,0x1b0,0xe0,0xe0,0x1b0,0x318,0x71c,0x60c,0xe0e,0xc06,0x0,0x0,0x0,0x0}}, // 'X'
+	{14, {0x0,0x0,0x0,0x0,0x0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x1e0,0x330,0x618,0x618,0xc0c,0xc0c,0x1806,0x1806,0x0,0x0,0x0,0x0}}, // 'Y'
+	{12, {0x0,0x0,0x0,0x0,0x0,0x7fe,0x7fe,0x6,0xc,0x18,0x30,0x70,0x60,0xc0,0x180,0x300,0x600,0x7fe,0x7fe,0x0,0x0,0x0,0x0}}, // 'Z'
+	{ 5, {0x0,0x1e,0x1e,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x1e,0x1e,0x0,0x0,0x0,0x0}}, // '['
+	{ 5, {0x0,0x0,0x0,0x0,0x0,0x18,0x18,0x8,0x8,0xc,0xc,0x4,0x4,0x6,0x6,0x2,0x2,0x3,0x3,0x0,0x0,0x0,0x0}}, // '\\'
+	{ 5, {0x0,0xf,0xf,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xf,0xf,0x0,0x0,0x0,0x0}}, // ']'
+	{ 9, {0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x82,0xc6,0x6c,0x38,0x10,0x0,0x0,0x0,0x0,0x0}}, // '^'
+	{10, {0x0,0x3ff,0x3ff,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // '_'
+	{ 4, {0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x6,0x6,0x2,0x2,0x4,0x0,0x0,0x0,0x0}}, // '`'
+	{ 9, {0x0,0x0,0x0,0x0,0x0,0xdc,0xee,0xc6,0xc6,0xce,0xfc,0xe0,0xc6,0xee,0x7c,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'a'
+	{11, {0x0,0x0,0x0,0x0,0x0,0xf6,0x1fe,0x18e,0x306,0x306,0x306,0x306,0x18e,0x1fe,0xf6,0x6,0x6,0x6,0x6,0x0,0x0,0x0,0x0}}, // 'b'
+	{10, {0x0,0x0,0x0,0x0,0x0,0xf8,0x1fc,0x18c,0x6,0x6,0x6,0x6,0x18c,0x1fc,0xf8,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'c'
+	{11, {0x0,0x0,0x0,0x0,0x0,0x378,0x3fc,0x38c,0x306,0x306,0x306,0x306,0x38c,0x3fc,0x378,0x300,0x300,0x300,0x300,0x0,0x0,0x0,0x0}}, // 'd'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x78,0x1fc,0x18e,0x6,0x6,0x1fe,0x186,0x186,0xfc,0x78,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'e'
+	{ 6, {0x0,0x0,0x0,0x0,0x0,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0xc,0x3f,0x3f,0xc,0xc,0x3c,0x38,0x0,0x0,0x0,0x0}}, // 'f'
+	{11, {0x0,0x70,0x1fc,0x18c,0x300,0x378,0x3fc,0x38c,0x306,0x306,0x306,0x306,0x30c,0x3fc,0x378,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'g'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x186,0x186,0x186,0x186,0x186,0x186,0x186,0x18e,0x1f6,0xe6,0x6,0x6,0x6,0x6,0x0,0x0,0x0,0x0}}, // 'h'
+	{ 4, {0x0,0x0,0x0,0x0,0x0,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x0,0x0,0x6,0x6,0x0,0x0,0x0,0x0}}, // 'i'
+	{ 4, {0x0,0x3,0x7,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x0,0x0,0x6,0x6,0x0,0x0,0x0,0x0}}, // 'j'
+	{ 9, {0x0,0x0,0x0,0x0,0x0,0x1c6,0xc6,0xe6,0x66,0x36,0x3e,0x1e,0x36,0x66,0xc6,0x6,0x6,0x6,0x6,0x0,0x0,0x0,0x0}}, // 'k'
+	{ 4, {0x0,0x0,0x0,0x0,0x0,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x0,0x0,0x0,0x0}}, // 'l'
+	{14, {0x0,0x0,0x0,0x0,0x0,0x18c6,0x18c6,0x18c6,0x18c6,0x18c6,0x18c6,0x18c6,0x19ce,0x1ef6,0xc66,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'm'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x186,0x186,0x186,0x186,0x186,0x186,0x186,0x18e,0x1f6,0xe6,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'n'
+	{11, {0x0,0x0,0x0,0x0,0x0,0xf8,0x1fc,0x18c,0x306,0x306,0x306,0x306,0x18c,0x1fc,0xf8,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'o'
+	{11, {0x0,0x6,0x6,0x6,0x6,0xf6,0x1fe,0x18e,0x306,0x306,0x306,0x306,0x18e,0x1fe,0xf6,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'p'
+	{11, {0x0,0x300,0x300,0x300,0x300,0x378,0x3fc,0x38c,0x306,0x306,0x306,0x306,0x38c,0x3fc,0x378,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'q'
+	{ 6, {0x0,0x0,0x0,0x0,0x0,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0xe,0x36,0x36,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'r'
+	{ 9, {0x0,0x0,0x0,0x0,0x0,0x3c,0x7e,0xc6,0xc0,0xf8,0x7e,0x6,0xc6,0xfc,0x78,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 's'
+	{ 6, {0x0,0x0,0x0,0x0,0x0,0x18,0x1c,0xc,0xc,0xc,0xc,0xc,0xc,0x3f,0x3f,0xc,0xc,0xc,0x0,0x0,0x0,0x0,0x0}}, // 't'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x19c,0x1be,0x1c6,0x186,0x186,0x186,0x186,0x186,0x186,0x186,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'u'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x30,0x30,0x78,0x48,0xcc,0xcc,0xcc,0x186,0x186,0x186,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'v'
+	{14, {0x0,0x0,0x0,0x0,0x0,0x330,0x330,0x738,0x528,0xd2c,0xccc,0xccc,0x18c6,0x18c6,0x18c6,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'w'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x186,0x1ce,0xcc,0x78,0x30,0x30,0x78,0xcc,0x1ce,0x186,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'x'
+	{10, {0x0,0x1c,0x1c,0x30,0x30,0x30,0x30,0x78,0x48,0xcc,0xcc,0xcc,0x186,0x186,0x186,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'y'
+	{ 9, {0x0,0x0,0x0,0x0,0x0,0xfe,0xfe,0x6,0xc,0x18,0x30,0x60,0xc0,0xfe,0xfe,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // 'z'
+	{ 6, {0x0,0x30,0x18,0xc,0xc,0xc,0xc,0xc,0xc,0x6,0x3,0x6,0xc,0xc,0xc,0xc,0xc,0x18,0x30,0x0,0x0,0x0,0x0}}, // '{'
+	{ 4, {0x0,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x6,0x0,0x0,0x0,0x0}}, // '|'
+	{ 6, {0x0,0x3,0x6,0xc,0xc,0xc,0xc,0xc,0xc,0x18,0x30,0x18,0xc,0xc,0xc,0xc,0xc,0x6,0x3,0x0,0x0,0x0,0x0}}, // '}'
+	{10, {0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x66,0xfc,0x198,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}, // '~'
+};
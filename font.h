@@ -0,0 +1,19 @@
+#ifndef __FONT_H__
+#define __FONT_H__
+
+// Bitmap font for printable ASCII, built into the program so text needs neither GLUT nor a window
+#define FONT_FIRST_CHAR 32
+#define FONT_CHARS 95
+#define FONT_HEIGHT 23
+// rows below the baseline
+#define FONT_DESCENT 5
+// widest glyph
+#define FONT_MAX_WIDTH 18
+
+struct FontGlyph {
+	int width; // also how far the pen moves after the glyph
+	unsigned int rows[FONT_HEIGHT]; // bottom row first, bit x set if pixel x is
+};
+extern const FontGlyph fontGlyphs[FONT_CHARS];
+
+#endif // __FONT_H__
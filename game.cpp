@@ -0,0 +1,611 @@
+/* Steven Huang
+ * 301223245
+ * sha152
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include "game.h"
+#include "replay.h"
+
+using namespace std;
+
+const vec4 fruitColours[MaxFruitColours] = {grape, apple, banana, pear, orange};
+
+// vector sorting
+struct sortByIncY { bool operator() (Cell const &L, Cell const &R) { return L.y < R.y; } };
+
+//-------------------------------------------------------------------------------------------------------------------
+// the tile can be released if all of its cells are above the board and none are occupied
+template<class Size>
+int BasicGameState<Size>::canRelease() const {
+	int x = currTilePos.x, y = currTilePos.y;
+	return board.fitsColumns(currTileFootprint, x) && y + currTileFootprint.minY >= 0
+		&& !board.overlaps(currTileFootprint, x, y);
+}
+
+// A tile above the top of every column it covers lands with its lowest cell of some column on that column's height,
+// which takes a look at each of its columns. A tile below an overhang falls past it row by row instead
+template<class Size>
+int BasicGameState<Size>::landingRow() const {
+	const TileFootprint &f = currTileFootprint;
+	if(!board.fitsColumns(f, currTilePos.x)) return currTilePos.y;
+	int x = currTilePos.x + f.minX, y = currTilePos.y;
+	int land = -f.minY; // on the floor
+	bool aboveStack = y + f.minY >= 0;
+	for(int c = 0; c <= f.maxX - f.minX; c++) {
+		land = max(land, heights[x + c] - f.bottom[c]);
+		aboveStack = aboveStack && y + f.bottom[c] >= heights[x + c];
+	}
+	if(aboveStack) return land;
+	while(tileFreeToFall(Cell(currTilePos.x, y))) y--;
+	return y;
+}
+
+// When the current tile is moved or rotated (or created), the tile follows the robot arm until it is released
+template<class Size>
+void BasicGameState<Size>::updatetile() {
+	if(gui[TextGG]) return;
+	if(!tileFalling)
+		currTilePos = arm.getTip();
+	result.tileChanged = true;
+}
+
+// turns a joint a step at once, taking over from a planned path unless the arm is taking a timed out tile away
+template<class Size>
+void BasicGameState<Size>::turnArm(int joint, GLfloat degrees) {
+	if(releaseOnArrival) return;
+	scheduler.cancel(EventArmMove);
+	arm.turn(joint, degrees);
+	updatetile();
+}
+
+template<class Size>
+void BasicGameState<Size>::startArmPath() {
+	armPathStart = now();
+	scheduler.schedule(EventArmMove, TICK_MS);
+}
+
+// poses the arm where its path has it by now
+template<class Size>
+void BasicGameState<Size>::moveArm() {
+	int k = now() - armPathStart;
+	GLfloat theta[robot::NumAngles];
+	armPath.at(k, theta);
+	arm.setAngles(theta[robot::LowerArm], theta[robot::UpperArm]);
+	updatetile();
+	if(k < armPath.ticks()) {
+		scheduler.schedule(EventArmMove, TICK_MS);
+	} else if(releaseOnArrival) {
+		// the path took the short way round, which is the same pose
+		arm.setAngles(arm.getGeometry().homeLower, arm.getGeometry().homeUpper);
+		updatetile();
+		releaseOnArrival = false;
+		startFastDrop();
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+// Called to keep the tile within the bounds of the board by nudging the tile into place
+template<class Size>
+bool BasicGameState<Size>::nudgeCurrentTile(const Cell *o) {
+	for(int i = 0; i < 4; i++) {
+		Cell p = currTilePos + o[i];
+		if(isInBounds(p) && isCellOccupied(p)) return false;
+	}
+	for(int i = 0; i < 4; i++) {
+		Cell p = currTilePos + o[i];
+		if(!isInBounds(p)) currTilePos -= o[i];
+	}
+	return true;
+}
+template<class Size>
+bool BasicGameState<Size>::nudgeCurrentTile(int cellOffsetX, int cellOffsetY) {
+	int cellX = currTilePos.x + cellOffsetX;
+	int cellY = currTilePos.y + cellOffsetY;
+	if(isInBounds(cellX,cellY) && isCellOccupied(cellX, cellY)) return false;
+	currTilePos.x -= cellX<0 ? cellOffsetX : cellX>size.width - 1 ? cellOffsetX : 0;
+	currTilePos.y -= cellY>size.height - 1 ? cellOffsetY : cellY<0 ? cellOffsetY : 0;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+template<class Size>
+void BasicGameState<Size>::shuffleColours() {
+	unsigned char temp = currTileFruits[0];
+	for(int i = 0; i < 4 - 1; i++)
+		currTileFruits[i] = currTileFruits[i + 1];
+	currTileFruits[3] = temp;
+
+	result.tileChanged = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+// Called at the start of play and every time a tile is placed
+template<class Size>
+void BasicGameState<Size>::newtile() {
+	releaseOnArrival = false;
+	if(gui[TextGG]) return;
+	tileDropSpeed = TILE_DROP_SPEED;
+	//currTilePos = Cell(rand() % size.width, size.height - 1); // Put the tile at the top of the board
+	currTilePos = arm.getTip();
+
+	currTileShapeIndex = rng.below(MaxTileShapes);
+	for(int i = 0; i < 4; i++) {
+		currTileFruits[i] = rng.below(MaxFruitColours);
+		currTileOffset[i] = allShapes[currTileShapeIndex][i];
+		//nudgeCurrentTile(currTileOffset[i].x, currTileOffset[i].y);
+	}
+	currTileRotation = 0;
+	currTileFootprint = tileOrientations.o[currTileShapeIndex][0].footprint;
+	rotateCurrentTile(rng.below(MAX_TILE_ORIENTATIONS));
+	shuffleColours();
+	updatetile();
+
+	// can't lose! ;)
+	for(int i = 0; rules.canLose && i < 4; i++) {
+		if(isCellOccupied(currTilePos + currTileOffset[i])) {
+			gui[TextGG] = 1;
+		}
+	}
+}
+
+template<class Size>
+void BasicGameState<Size>::reset(uint64_t s) {
+	scheduler.reset();
+	restart(s);
+}
+
+// Starts the game over - empties the board, creates new tiles, resets line counters
+template<class Size>
+void BasicGameState<Size>::restart(uint64_t s) {
+	seed = s;
+	rng.seed(s);
+	result.clear();
+	scheduler.clear();
+	scheduler.schedule(EventGripTimeout, MAX_GRIP_TIME*1000);
+	fastDropping = false;
+	releaseOnArrival = false;
+	tileDropSpeed = TILE_DROP_SPEED;
+	tileFalling = false;
+	removedCells.clear();
+
+	// Initially no cell is occupied
+	board.clear();
+	updateHeights();
+	for(int i = 0; i < size.width*size.height; i++)
+		cellFruits[i] = NO_FRUIT;
+	dirty.fill();
+	result.boardChanged = true;
+
+	arm.reset(robot::armGeometry(size.width, size.height));
+
+	gui[TextGG] = 0;
+	tilesPlaced = 0;
+	gui[TextScore] = 0;
+	gui[TextCells] = 0;
+	gui[TextRows] = 0;
+	gui[GripTime] = MAX_GRIP_TIME;
+
+	currTilePos = Cell(size.width/2, size.height - 1);
+	currTileShapeIndex = 0;
+	newtile(); // create new next tile
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+// Turns the current tile turns quarter turns clockwise, nudge to make room
+template<class Size>
+void BasicGameState<Size>::rotateCurrentTile(int turns) {
+	if(turns % MAX_TILE_ORIENTATIONS == 0) return;
+	if(currTileShapeIndex == TileShapeO) { shuffleColours(); return; }
+	int rotation = (currTileRotation + turns) % MAX_TILE_ORIENTATIONS;
+	const TileOrientation &next = tileOrientations.o[currTileShapeIndex][rotation];
+	// if cannot nudge tile back into valid bounds, cancel rotation
+	if(!nudgeCurrentTile(next.offsets)) return;
+	// otherwise apply this rotation
+	for(int i = 0; i < 4; i++) currTileOffset[i] = next.offsets[i];
+	currTileRotation = rotation;
+	currTileFootprint = next.footprint;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// sets the occupancy of the specified cell, lowering the column height to the next occupied cell if it was the top
+template<class Size>
+void BasicGameState<Size>::setCellOccupied(int x, int y, bool o) {
+	board.setOccupied(x, y, o);
+	dirty.setOccupied(x, y, true);
+	if(o) heights[x] = max(heights[x], y + 1);
+	else if(y + 1 == heights[x])
+		while(heights[x] > 0 && !board.isOccupied(x, heights[x] - 1)) heights[x]--;
+}
+
+// recomputes every column height from the top row down, after rows of the board were moved as a whole
+template<class Size>
+void BasicGameState<Size>::updateHeights() {
+	BoardRow seen = 0;
+	for(int x = 0; x < size.width; x++) heights[x] = 0;
+	for(int y = size.height - 1; y >= 0 && seen != board.fullRow(); y--) {
+		BoardRow top = board.rows[y] & ~seen;
+		for(; top; top &= top - 1)
+			heights[lowestBit(top)] = y + 1;
+		seen |= board.rows[y];
+	}
+}
+
+// sets the fruit of the specified cell to f
+template<class Size>
+void BasicGameState<Size>::setCellFruit(int x, int y, unsigned char f) {
+	cellFruits[size.width*y + x] = f;
+	dirty.setOccupied(x, y, true);
+	result.boardChanged = true;
+}
+
+// Places the current tile - update the board fruits and the bitboard maintaining occupied cells
+template<class Size>
+void BasicGameState<Size>::setTileColour(const Cell &p) {
+	for(int i = 0; i < 4; i++) {
+		int cellX = p.x + currTileOffset[i].x;
+		int cellY = p.y + currTileOffset[i].y;
+		// cells above the top of a full board are lost
+		if(!isInBounds(cellX, cellY)) continue;
+		setCellOccupied(cellX, cellY, true);
+		setCellFruit(cellX, cellY, currTileFruits[i]);
+	}
+}
+
+// the tile can fall if its lowest cell is above the floor and the rows below are free
+template<class Size>
+bool BasicGameState<Size>::tileFreeToFall(const Cell &p) const {
+	if(p.y + currTileFootprint.minY - 1 < 0) return false;
+	return !board.overlaps(currTileFootprint, p.x, p.y - 1);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+// Given (x,y), tries to move the tile x squares to the right and y squares down
+// Returns true if the tile was successfully moved, or false if there was some issue
+template<class Size>
+bool BasicGameState<Size>::moveTile(const Cell &direction) const {
+	int x = currTilePos.x + direction.x, y = currTilePos.y + direction.y;
+	if(!board.fitsColumns(currTileFootprint, x)) return false;
+	if(y + currTileFootprint.minY < 0 || y + currTileFootprint.maxY > size.height - 1) return false;
+	return !board.overlaps(currTileFootprint, x, y);
+}
+
+// fills the board with n (x, y, colour) triples; the cells a small board has no room for are left out
+template<class Size>
+void BasicGameState<Size>::loadTestPattern(const int *cells, int n) {
+	for(int i = 0; i < n; i+=3) {
+		if(!isInBounds(cells[i], cells[i+1])) continue;
+		setCellFruit(cells[i], cells[i+1], cells[i+2]);
+		setCellOccupied(cells[i], cells[i+1], true);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+// removes the cell at p from the board
+template<class Size>
+void BasicGameState<Size>::removeCellFromBoard(const Cell &p) {
+	gui[TextScore]+=5;
+	gui[TextCells]++;
+	setCellOccupied(p, false);
+	result.removedCells.push_back(p);
+}
+
+// Fills run with (x,y) followed by the occupied cells of the same fruit next to it in direction (dx,dy), then in
+// the opposite direction. Removed cells keep their fruit, so (x,y) itself doesn't have to be occupied
+template<class Size>
+void BasicGameState<Size>::findFruitRun(int x, int y, int dx, int dy, FruitRun &run) const {
+	run.count = 0;
+	if(!isInBounds(x, y)) return;
+	unsigned char fruit = cellFruits[size.width*y + x];
+	run.cells[run.count++] = size.width*y + x;
+	for(int dir = 1; dir >= -1; dir -= 2) {
+		int cx = x + dir*dx, cy = y + dir*dy;
+		while(board.isOccupied(cx, cy) && cellFruits[size.width*cy + cx] == fruit) {
+			run.cells[run.count++] = size.width*cy + cx;
+			cx += dir*dx;
+			cy += dir*dy;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+// Collapses every column with removed cells in one sweep: the cells above the lowest hole of a column keep their order
+// and drop onto each other, closing every gap. The cells that moved are then checked for grouped fruits; new groups
+// are removed and collapsed on the next EventColumnCheck. Front ends animate the fall from result.droppedCells
+template<class Size>
+void BasicGameState<Size>::checkFruitColumn() {
+	int lowestHole[Size::maxWidth];
+	for(int x = 0; x < size.width; x++) lowestHole[x] = size.height;
+	for(size_t i = 0; i < removedCells.size(); i++)
+		lowestHole[removedCells[i].x] = min(lowestHole[removedCells[i].x], removedCells[i].y);
+	removedCells.clear();
+
+	int moved[Size::maxWidth*Size::maxHeight], numMoved = 0;
+	for(int x = 0; x < size.width; x++) {
+		int to = lowestHole[x];
+		for(int y = to; y < size.height; y++) {
+			if(!board.isOccupied(x, y)) continue;
+			if(y != to) {
+				setCellOccupied(x, y, false);
+				setCellOccupied(x, to, true);
+				setCellFruit(x, to, getCellFruit(x, y));
+				setCellFruit(x, y, NO_FRUIT);
+				moved[numMoved++] = size.width*to + x;
+				result.droppedCells.push_back(CellDrop(Cell(x, to), y - to));
+			}
+			to++;
+		}
+	}
+
+	for(int i = 0; i < numMoved; i++) {
+		gui[TextScore] += 10;
+		checkGroupedFruits(Cell(moved[i] % size.width, moved[i] / size.width));
+	}
+}
+
+// checks all cells in same column/row that are the same colour of the cell in position p, removing the first
+// MAX_FRUIT_GROUP of a row (or else column) that is long enough
+template<class Size>
+void BasicGameState<Size>::checkGroupedFruits(const Cell &p) {
+	FruitRun horzGroup, vertGroup;
+	findFruitRun(p.x, p.y, 1, 0, horzGroup);
+	findFruitRun(p.x, p.y, 0, -1, vertGroup);
+	const FruitRun &group = horzGroup.count >= MAX_FRUIT_GROUP ? horzGroup : vertGroup;
+
+	for(int k = 0; group.count >= MAX_FRUIT_GROUP && k < MAX_FRUIT_GROUP; k++)
+		if(!board.isOccupied(group.cells[k] % size.width, group.cells[k] / size.width)) return;
+	for(int k = 0; group.count >= MAX_FRUIT_GROUP && k < MAX_FRUIT_GROUP; k++) {
+		Cell cell(group.cells[k] % size.width, group.cells[k] / size.width);
+		removedCells.push_back(cell);
+		removeCellFromBoard(cell);
+	}
+	scheduler.schedule(EventColumnCheck, tileDropSpeed);
+}
+
+// Clears every full row from lo to hi (0 is the bottom row) at once: the cells of the full rows are removed and
+// the rows above move down over them in one pass, copying whole rows of the bitboard and the fruit grid.
+// Returns a mask with bit y set for each row y that was cleared
+template<class Size>
+RowMask BasicGameState<Size>::clearFullRows(int lo, int hi) {
+	lo = max(lo, 0); hi = min(hi, size.height - 1);
+	RowMask cleared = 0;
+	for(int y = lo; y <= hi; y++) {
+		if(!board.isRowFull(y)) continue;
+		gui[TextScore] += 50;
+		gui[TextRows]++;
+		cleared |= (RowMask)1 << y;
+		for(int x = 0; x < size.width; x++)
+			removeCellFromBoard(Cell(x, y));
+	}
+	if(!cleared) return 0;
+
+	// fruits of the cleared rows, kept where nothing moves over them so that the cells can still fade out
+	unsigned char clearedFruits[Size::maxHeight][Size::maxWidth];
+	int first = -1, to = 0;
+	for(int y = lo; y <= hi; y++) {
+		if(!(cleared >> y & 1)) continue;
+		memcpy(clearedFruits[y], &cellFruits[size.width*y], size.width);
+		if(first < 0) first = to = y;
+	}
+	// move each run of kept rows above the first cleared row down with one copy
+	for(int y = first; y < size.height;) {
+		if(cleared >> y & 1) { y++; continue; }
+		int end = y;
+		while(end < size.height && !(cleared >> end & 1)) end++;
+		memmove(&board.rows[to], &board.rows[y], (end - y)*sizeof(BoardRow));
+		memmove(&cellFruits[size.width*to], &cellFruits[size.width*y], (end - y)*size.width);
+		to += end - y;
+		y = end;
+	}
+	for(int y = to; y < size.height; y++) {
+		board.rows[y] = 0;
+		memset(&cellFruits[size.width*y], NO_FRUIT, size.width);
+	}
+	for(int y = lo; y <= hi; y++)
+		for(int x = 0; cleared >> y & 1 && x < size.width; x++)
+			if(!board.isOccupied(x, y)) cellFruits[size.width*y + x] = clearedFruits[y][x];
+
+	updateHeights();
+
+	// everything from the first cleared row up changed, which the front end uploads as one range
+	for(int y = first; y < size.height; y++)
+		dirty.rows[y] = board.fullRow();
+	result.boardChanged = true;
+	return cleared;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+// starts fast dropping the tile unless it already is
+template<class Size>
+void BasicGameState<Size>::startFastDrop() {
+	if(fastDropping) return;
+	fastDropping = true;
+	tileDrop(EventFastDropTick);
+}
+
+// drops the tile straight onto its landing row and places it at once
+template<class Size>
+void BasicGameState<Size>::hardDrop() {
+	scheduler.cancel(EventDropTick);
+	currTilePos.y = landingRow();
+	placeTile();
+}
+
+// places the tile where it is, removes what it completes and brings in the next tile
+template<class Size>
+void BasicGameState<Size>::placeTile() {
+	fastDropping = false;
+	scheduler.cancel(EventFastDropTick);
+	setTileColour(currTilePos);
+	tilesPlaced++;
+	// tile deletion is disabled by default ;)
+	if(rules.clearCells) {
+		RowMask cleared = clearFullRows(currTilePos.y + currTileFootprint.minY, currTilePos.y + currTileFootprint.maxY);
+		// the cells of the tile left on the board, moved down by the rows cleared below them
+		vector<Cell> lowestYCellsFirst;
+		for(int i = 0; i < 4; i++) {
+			Cell cell = currTilePos + currTileOffset[i];
+			// cells off the board were lost by setTileColour()
+			if(!isInBounds(cell.x, cell.y) || cleared >> cell.y & 1) continue;
+			for(int y = cell.y - 1; y >= 0; y--) cell.y -= cleared >> y & 1;
+			lowestYCellsFirst.push_back(cell);
+		}
+		sort(lowestYCellsFirst.begin(), lowestYCellsFirst.end(), sortByIncY());
+		for(int i = 0; i < (int)lowestYCellsFirst.size(); i++) {
+			FruitRun horzGroup;
+			findFruitRun(lowestYCellsFirst[i].x, lowestYCellsFirst[i].y, 1, 0, horzGroup);
+			if(horzGroup.count >= MAX_FRUIT_GROUP) {
+				checkGroupedFruits(lowestYCellsFirst[i]);
+			} else if(i == (int)lowestYCellsFirst.size() - 1) {
+				for(int k = 0; k < (int)lowestYCellsFirst.size(); k++) checkGroupedFruits(lowestYCellsFirst[k]);
+			}
+		}
+	}
+	newtile();
+	tileFalling = false;
+}
+
+// main loop that handles the moving down of the tile and other game logic
+template<class Size>
+void BasicGameState<Size>::tileDrop(GameEvent type) {
+	switch(type) {
+		case EventDropTick:
+			if(tileFreeToFall(currTilePos)) {
+				currTilePos.y -= 1;
+				tileFalling = true;
+				updatetile();
+				scheduler.schedule(EventDropTick, tileDropSpeed);
+			} else {
+				placeTile();
+			}
+			return;
+		case EventFastDropTick:
+			if(tileFreeToFall(currTilePos)){
+				currTilePos.y -= 1;
+				tileFalling = true;
+				updatetile();
+				scheduler.schedule(EventFastDropTick, TILE_DROP_SPEED_FAST);
+			} else {
+				scheduler.schedule(EventDropTick, TILE_DROP_SPEED);
+			}
+			return;
+		case EventColumnCheck:
+			checkFruitColumn();
+			return;
+		case EventGripTimeout:
+			scheduler.schedule(EventGripTimeout, MAX_GRIP_TIME*1000);
+			// if can't release, move arm to middle and release there
+			if(!canRelease()) {
+				armPath.start(arm.getTheta());
+				armPath.add(arm.getGeometry().homeLower, arm.getGeometry().homeUpper);
+				releaseOnArrival = true;
+				startArmPath();
+				return;
+			}
+			startFastDrop();
+			return;
+		case EventArmMove:
+			moveArm();
+			return;
+		default: assert(!"tileDrop() called with an event it doesn't handle"); return;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+template<class Size>
+const StepResult &BasicGameState<Size>::step(GameInput input, const Cell &goal) {
+	// various test cases. press t or z to find out!
+	static const int test[] = {
+		0, 0, ColourApple, 0, 1, ColourApple, 0, 2, ColourGrape, 0, 3, ColourGrape, 0, 4, ColourApple, 0, 5, ColourApple,
+		3, 0, ColourApple, 3, 1, ColourApple,
+		4, 0, ColourApple, 4, 1, ColourApple, 4, 2, ColourGrape,
+		5, 0, ColourGrape, 5, 1, ColourGrape, 5, 2, ColourApple,
+		7, 0, ColourGrape, 7, 1, ColourGrape, 7, 2, ColourApple
+	};
+	static const int test2[] = {
+		4, 0, ColourApple, 4, 1, ColourGrape, 4, 2, ColourGrape,
+		5, 0, ColourApple, 5, 1, ColourApple, 5, 2, ColourGrape,
+		6, 1, ColourApple
+	};
+	result.clear();
+	if(recorder) recorder->record(now(), input, input == InputArmGoal ? goal : Cell());
+	switch(input) {
+		case InputRotateTile:
+			rotateCurrentTile(1);
+			updatetile();
+			break;
+		case InputShuffleColours:
+			shuffleColours();
+			updatetile();
+			break;
+		case InputReleaseTile:
+			if(canRelease())
+				scheduler.schedule(EventDropTick, 0);
+			break;
+		case InputFastDrop:
+			if(canRelease())
+				startFastDrop();
+			break;
+		case InputLowerArmCCW: turnArm(robot::LowerArm, arm.getGeometry().jointStep); break;
+		case InputLowerArmCW:  turnArm(robot::LowerArm, -arm.getGeometry().jointStep); break;
+		case InputUpperArmCCW: turnArm(robot::UpperArm, arm.getGeometry().jointStep); break;
+		case InputUpperArmCW:  turnArm(robot::UpperArm, -arm.getGeometry().jointStep); break;
+		case InputTestPattern1: loadTestPattern(test, sizeof(test)/sizeof(int)); break;
+		case InputTestPattern2: loadTestPattern(test2, sizeof(test2)/sizeof(int)); break;
+		// the next game is seeded from this one so that restarts are reproducible too; the halves are drawn one
+		// statement at a time, since the order of two calls in one expression is up to the compiler
+		case InputRestart: {
+			uint64_t high = rng.next();
+			uint64_t low = rng.next();
+			restart(high << 32 | low);
+			break;
+		}
+		case InputHardDrop:
+			// a tile pushed off the board's columns or below its floor while falling has nowhere to land
+			if((tileFalling || canRelease()) && board.fitsColumns(currTileFootprint, currTilePos.x)
+				&& currTilePos.y + currTileFootprint.minY >= 0)
+				hardDrop();
+			break;
+		case InputArmGoal:
+			if(!releaseOnArrival && robot::planArmPath(arm.getGeometry(), arm.getTheta(), goal, currTileFootprint, heights,
+				size.width, armPath))
+				startArmPath();
+			break;
+		default: break;
+	}
+	return result;
+}
+
+template<class Size>
+const StepResult &BasicGameState<Size>::tick() {
+	result.clear();
+	scheduler.advance();
+	GameEvent ev;
+	while(scheduler.pop(ev))
+		tileDrop(ev);
+	gui[GripTime] = scheduler.timeLeft(EventGripTimeout)/1000.0;
+	return result;
+}
+
+template<class Size>
+void BasicGameState<Size>::record(Replay *r) {
+	recorder = r;
+	if(!r) return;
+	r->rules = rules;
+	r->width = size.width;
+	r->height = size.height;
+}
+
+template class BasicGameState<StandardBoardSize>;
+template class BasicGameState<RuntimeBoardSize>;
@@ -0,0 +1,249 @@
+#ifndef __GAME_H__
+#define __GAME_H__
+
+#include <vector>
+#include "include/Angel.h"
+#include "bitboard.h"
+#include "arm.h"
+#include "motion.h"
+#include "rng.h"
+#include "scheduler.h"
+#include "tiles.h"
+
+// misc constants
+#define TILE_DROP_SPEED 200
+#define TILE_DROP_SPEED_FAST 20
+#define MAX_FRUIT_GROUP 3
+#define MAX_GRIP_TIME 5
+
+// information to draw to screen
+enum Text {
+	TextScore,
+	TextCells,
+	TextRows,
+	TextGG,
+	GripTime,
+	TextMax
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+const vec4 cellFreeColour = vec4(1.0, 1.0, 1.0, 0.0);
+// fruit colors: https://kuler.adobe.com/create/color-wheel/?base=2&rule=Custom&selected=3&name=My%20Kuler%20Theme&mode=rgb&rgbvalues=1,0.8626810137791381,0,0.91,0.5056414909356977,0,1,0.10293904996979109,0,0.5587993310653088,0,0.91,0.1658698853207745,1,0.10159077034733333&swatchOrder=0,1,2,3,4
+const vec4 grape  = vec4(142/255.0 ,  54/255.0 , 232/255.0 , 1.0);
+const vec4 apple  = vec4(255/255.0 ,  26/255.0 ,   0/255.0 , 1.0);
+const vec4 banana = vec4(255/255.0 , 220/255.0 ,   0/255.0 , 1.0);
+const vec4 pear   = vec4( 42/255.0 , 255/255.0 ,  26/255.0 , 1.0);
+const vec4 orange = vec4(232/255.0 , 129/255.0 ,   0/255.0 , 1.0);
+enum FruitColours {
+	ColourGrape,
+	ColourApple,
+	ColourBanana,
+	ColourPear,
+	ColourOrange,
+	MaxFruitColours
+};
+extern const vec4 fruitColours[MaxFruitColours];
+// fruit of a cell that was never given one
+const unsigned char NO_FRUIT = MaxFruitColours;
+// The game only keeps the FruitColours of cells and tiles; front ends look up the colour to draw with here
+inline const vec4 &fruitColour(unsigned char f) { return f < MaxFruitColours ? fruitColours[f] : cellFreeColour; }
+
+//-------------------------------------------------------------------------------------------------------------------
+// Rules the game is played with by default leaves out (see README); headless drivers can turn them on
+struct GameRules {
+	bool clearCells; // full rows and groups of MAX_FRUIT_GROUP same fruits are removed when a tile lands
+	bool canLose;    // the game is over when a new tile overlaps the board
+
+	GameRules() : clearCells(false), canLose(false) {}
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+class Replay;
+
+// Player actions; everything else happens on timed events of the game's Scheduler
+enum GameInput {
+	InputNone,
+	InputRotateTile,
+	InputShuffleColours,
+	InputReleaseTile,
+	InputFastDrop,
+	InputLowerArmCCW,
+	InputLowerArmCW,
+	InputUpperArmCCW,
+	InputUpperArmCW,
+	InputTestPattern1,
+	InputTestPattern2,
+	InputRestart,
+	InputHardDrop,
+	InputArmGoal, // the arm moves the tile to the goal cell given with it, over the stack
+	MaxGameInputs
+};
+
+// A cell that fell rows cells onto cell to when its column collapsed; the game moves it at once, front ends may
+// animate the fall
+struct CellDrop {
+	Cell to;
+	int rows;
+
+	CellDrop(const Cell &to, int rows) : to(to), rows(rows) {}
+};
+
+// What changed during a step or tick, so that a front end only redraws what it has to
+struct StepResult {
+	std::vector<Cell> removedCells; // cells removed from the board, for the fade out animation
+	std::vector<CellDrop> droppedCells; // cells moved down by a column collapse
+	bool tileChanged; // the current tile moved, rotated, or changed colours
+	bool boardChanged; // a cell of the board changed colour
+
+	void clear() {
+		removedCells.clear();
+		droppedCells.clear();
+		tileChanged = boardChanged = false;
+	}
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// The rules of FruitTetris, with no dependency on GL or GLUT. A front end feeds inputs into step(), calls
+// tick() every TICK_MS of wall-clock time and renders the public state; headless drivers can call tick()
+// as fast as they like. Built for a board Size (see bitboard.h): GameState plays the standard board with every
+// board loop unrolled at compile time, RuntimeGameState any board up to MAX_BOARD_WIDTH by MAX_BOARD_HEIGHT
+template<class Size> class BasicGameState {
+public:
+	typedef BasicBitboard<Size> Board;
+
+	float gui[TextMax];
+
+	// current tile
+	Cell currTileOffset[4]; // displacement of each of the 4 cells from a 'center' piece of the tile, on the grid
+	Cell currTilePos; // The position of the current tile using grid coordinates ((0,0) is the bottom left corner)
+	int currTileShapeIndex;
+	int currTileRotation; // quarter turns clockwise from the shape in allShapes
+	TileFootprint currTileFootprint; // row masks of currTileOffset, kept in sync whenever the offsets change
+	unsigned char currTileFruits[4]; // FruitColours of the cells of the tile
+	bool tileFalling;
+
+	// robot arm holding the current tile
+	robot::Arm arm;
+
+	// seed the current game was started with; the same seed and inputs always play out the same game
+	uint64_t seed;
+	// tiles that landed since the game was reset
+	uint32_t tilesPlaced;
+
+	GameRules rules;
+
+	BasicGameState(uint64_t seed = 1, const GameRules &rules = GameRules(), const Size &size = Size())
+		: rules(rules), size(size), board(size), dirty(size), recorder(NULL) { reset(seed); }
+
+	// Starts a new game from tick 0
+	void reset(uint64_t seed);
+	// Applies one input and returns what changed; the result is valid until the next call to step() or tick().
+	// goal is the cell InputArmGoal sends the tip of the arm to
+	const StepResult &step(GameInput input, const Cell &goal = Cell());
+	// Advances the game clock by one tick, firing the events that are due, and returns what changed
+	const StepResult &tick();
+	// ticks since the game was reset
+	uint32_t now() const { return scheduler.now(); }
+	// records every input given to step() into r from now on, along with the rules and board size it plays back
+	// with; NULL to stop
+	void record(Replay *r);
+
+	int width() const { return size.width; }
+	int height() const { return size.height; }
+	bool isInBounds(int x, int y) const { return x >= 0 && x < size.width && y >= 0 && y < size.height; }
+	bool isInBounds(const Cell &p) const { return isInBounds(p.x, p.y); }
+
+	bool isCellOccupied(int x, int y) const { return board.isOccupied(x, y); }
+	bool isCellOccupied(const Cell &p) const { return board.isOccupied(p.x, p.y); }
+	// FruitColours of the cell, NO_FRUIT if nothing was ever placed there; removed cells keep their fruit
+	unsigned char getCellFruit(int x, int y) const { return cellFruits[size.width*y + x]; }
+	unsigned char getCellFruit(const Cell &p) const { return getCellFruit(p.x, p.y); }
+	int canRelease() const;
+	// whether the arm is on its way somewhere along a planned path
+	bool isArmMoving() const { return scheduler.isPending(EventArmMove); }
+	// rows of column x up to and including its topmost occupied cell, 0 if the column is empty
+	int getColumnHeight(int x) const { return heights[x]; }
+	// row currTilePos would come to rest on if the tile fell straight down from where it is; a tile outside the board's
+	// columns has no stack to land on and stays on its row
+	int landingRow() const;
+	// cells whose colour or occupancy changed since the last clearDirtyCells(), so a front end only
+	// re-uploads those
+	const Board &getDirtyCells() const { return dirty; }
+	void clearDirtyCells() { dirty.clear(); }
+	const Board &getBoard() const { return board; }
+
+private:
+	// longest line of cells on the board
+	static constexpr int MaxFruitRun = Size::maxWidth > Size::maxHeight ? Size::maxWidth : Size::maxHeight;
+	// A horizontal or vertical line of same fruit cells through one cell, in a fixed size buffer so that checking
+	// for groups never allocates
+	struct FruitRun {
+		int count;
+		int cells[MaxFruitRun]; // cell indices, width*y + x
+	};
+
+	Size size;
+	//board.rows[y] has bit x set if the cell (x,y) is occupied
+	Board board;
+	// FruitColours of each cell of the board, row by row
+	unsigned char cellFruits[Size::maxWidth*Size::maxHeight];
+	// column heights of board, kept up to date on every change of the board
+	int heights[Size::maxWidth];
+	// cells changed since the front end last looked
+	Board dirty;
+
+	// draws the shapes, colours and rotations of new tiles
+	Rng rng;
+
+	Scheduler scheduler;
+	Replay *recorder;
+
+	int tileDropSpeed;
+	// the tile is being fast dropped, either by the player or because the gripper timed out
+	bool fastDropping;
+	// path the arm follows from tick armPathStart, and whether the tile is released once it's done (the gripper timed
+	// out where it couldn't let go)
+	robot::ArmTrajectory armPath;
+	uint32_t armPathStart;
+	bool releaseOnArrival;
+	// vector of removed cells to perform column drops on
+	std::vector<Cell> removedCells;
+
+	StepResult result;
+
+	void setCellOccupied(const Cell &p, bool o) { setCellOccupied(p.x, p.y, o); }
+	void setCellOccupied(int x, int y, bool o);
+	void setCellFruit(const Cell &p, unsigned char f) { setCellFruit(p.x, p.y, f); }
+	void setCellFruit(int x, int y, unsigned char f);
+	void updateHeights();
+
+	void updatetile();
+	void turnArm(int joint, GLfloat degrees);
+	void startArmPath();
+	void moveArm();
+	bool nudgeCurrentTile(const Cell *o);
+	bool nudgeCurrentTile(int cellOffsetX, int cellOffsetY);
+	void shuffleColours();
+	void restart(uint64_t seed);
+	void newtile();
+	void rotateCurrentTile(int turns);
+	void setTileColour(const Cell &p);
+	bool tileFreeToFall(const Cell &p) const;
+	bool moveTile(const Cell &direction) const;
+	void loadTestPattern(const int *cells, int n);
+
+	void removeCellFromBoard(const Cell &p);
+	void findFruitRun(int x, int y, int dx, int dy, FruitRun &run) const;
+	void checkFruitColumn();
+	void checkGroupedFruits(const Cell &p);
+	RowMask clearFullRows(int lo, int hi);
+	void startFastDrop();
+	void hardDrop();
+	void placeTile();
+	void tileDrop(GameEvent type);
+};
+
+typedef BasicGameState<StandardBoardSize> GameState;
+typedef BasicGameState<RuntimeBoardSize> RuntimeGameState;
+
+#endif // __GAME_H__
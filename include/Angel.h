@@ -32,7 +32,14 @@
 //     this this "include" directory.
 //
 
-#ifdef __APPLE__  // include Mac OS X verions of headers
+#if defined(ANGEL_NO_GL)  // headless builds only need the GL scalar types
+typedef float         GLfloat;
+typedef int           GLint;
+typedef unsigned int  GLuint;
+typedef unsigned int  GLenum;
+typedef int           GLsizei;
+typedef void          GLvoid;
+#elif defined(__APPLE__)  // include Mac OS X verions of headers
 #  include <OpenGL/gl3.h>
 #  include <GLUT/glut.h>
 #else // non-Mac OS X operating systems
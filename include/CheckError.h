@@ -8,7 +8,9 @@
 #define __CHECKERROR_H__
 
 #include <stdio.h>
+#ifndef ANGEL_NO_GL
 #include <GL/gl.h>
+#endif
 
 
 // hide the error since we don't use these anyways
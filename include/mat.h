@@ -173,14 +173,16 @@ class mat2 {
 
 inline
 mat2 matrixCompMult( const mat2& A, const mat2& B ) {
-    return mat2( A[0][0]*B[0][0], A[0][1]*B[0][1],
-		 A[1][0]*B[1][0], A[1][1]*B[1][1] );
+    return mat2( vec2( A[0][0]*B[0][0], A[0][1]*B[0][1] ),
+		 vec2( A[1][0]*B[1][0], A[1][1]*B[1][1] ) );
 }
 
+//  The 4 float constructor takes its entries column by column, so the
+//    rows are built as vectors here and in matrixCompMult()
 inline
 mat2 transpose( const mat2& A ) {
-    return mat2( A[0][0], A[1][0],
-		 A[0][1], A[1][1] );
+    return mat2( vec2( A[0][0], A[1][0] ),
+		 vec2( A[0][1], A[1][1] ) );
 }
 
 //----------------------------------------------------------------------------
@@ -358,16 +360,18 @@ class mat3 {
 
 inline
 mat3 matrixCompMult( const mat3& A, const mat3& B ) {
-    return mat3( A[0][0]*B[0][0], A[0][1]*B[0][1], A[0][2]*B[0][2],
-		 A[1][0]*B[1][0], A[1][1]*B[1][1], A[1][2]*B[1][2],
-		 A[2][0]*B[2][0], A[2][1]*B[2][1], A[2][2]*B[2][2] );
+    return mat3( vec3( A[0][0]*B[0][0], A[0][1]*B[0][1], A[0][2]*B[0][2] ),
+		 vec3( A[1][0]*B[1][0], A[1][1]*B[1][1], A[1][2]*B[1][2] ),
+		 vec3( A[2][0]*B[2][0], A[2][1]*B[2][1], A[2][2]*B[2][2] ) );
 }
 
+//  The 9 float constructor takes its entries column by column, so the
+//    rows are built as vectors here and in matrixCompMult()
 inline
 mat3 transpose( const mat3& A ) {
-    return mat3( A[0][0], A[1][0], A[2][0],
-		 A[0][1], A[1][1], A[2][1],
-		 A[0][2], A[1][2], A[2][2] );
+    return mat3( vec3( A[0][0], A[1][0], A[2][0] ),
+		 vec3( A[0][1], A[1][1], A[2][1] ),
+		 vec3( A[0][2], A[1][2], A[2][2] ) );
 }
 
 //----------------------------------------------------------------------------
@@ -401,6 +405,10 @@ class mat4 {
 	    _m[3] = vec4( m30, m31, m32, m33 );
 	}
 
+#ifdef ANGEL_SSE
+    mat4( const mat4& m )
+	{ _m[0] = m._m[0];  _m[1] = m._m[1];  _m[2] = m._m[2];  _m[3] = m._m[3]; }
+#else
     mat4( const mat4& m )
 	{
 	    if ( *this != m ) {
@@ -410,6 +418,7 @@ class mat4 {
 		_m[3] = m._m[3];
 	    } 
 	}
+#endif
 
     //
     //  --- Indexing Operator ---
@@ -447,6 +456,46 @@ class mat4 {
     friend mat4 operator * ( const GLfloat s, const mat4& m )
 	{ return m * s; }
 	
+#if defined(ANGEL_AVX)
+    // two rows of the product at a time: each entry of rows i and i+1 spread
+    //   over its half of the register, times the row of m it weighs
+    mat4 operator * ( const mat4& m ) const {
+	mat4  a( 0.0 );
+	const __m128 *b = reinterpret_cast<const __m128*>( &m._m[0].x );
+	__m256 b0 = _mm256_broadcast_ps( b );
+	__m256 b1 = _mm256_broadcast_ps( b + 1 );
+	__m256 b2 = _mm256_broadcast_ps( b + 2 );
+	__m256 b3 = _mm256_broadcast_ps( b + 3 );
+
+	for ( int i = 0; i < 4; i += 2 ) {
+	    __m256 r = _mm256_loadu_ps( &_m[i].x );
+	    __m256 c = _mm256_mul_ps( _mm256_shuffle_ps( r, r, 0x00 ), b0 );
+	    c = _mm256_add_ps( c, _mm256_mul_ps( _mm256_shuffle_ps( r, r, 0x55 ), b1 ) );
+	    c = _mm256_add_ps( c, _mm256_mul_ps( _mm256_shuffle_ps( r, r, 0xaa ), b2 ) );
+	    c = _mm256_add_ps( c, _mm256_mul_ps( _mm256_shuffle_ps( r, r, 0xff ), b3 ) );
+	    _mm256_storeu_ps( &a._m[i].x, c );
+	}
+
+	return a;
+    }
+#elif defined(ANGEL_SSE)
+    // row i of the product is the rows of m weighted by the entries of row i
+    mat4 operator * ( const mat4& m ) const {
+	mat4  a( 0.0 );
+	__m128 b0 = m._m[0].simd(), b1 = m._m[1].simd();
+	__m128 b2 = m._m[2].simd(), b3 = m._m[3].simd();
+
+	for ( int i = 0; i < 4; ++i ) {
+	    __m128 c = _mm_mul_ps( _mm_set1_ps( _m[i].x ), b0 );
+	    c = _mm_add_ps( c, _mm_mul_ps( _mm_set1_ps( _m[i].y ), b1 ) );
+	    c = _mm_add_ps( c, _mm_mul_ps( _mm_set1_ps( _m[i].z ), b2 ) );
+	    c = _mm_add_ps( c, _mm_mul_ps( _mm_set1_ps( _m[i].w ), b3 ) );
+	    a._m[i] = vec4( c );
+	}
+
+	return a;
+    }
+#else
     mat4 operator * ( const mat4& m ) const {
 	mat4  a( 0.0 );
 
@@ -460,6 +509,7 @@ class mat4 {
 
 	return a;
     }
+#endif
 
     //
     //  --- (modifying) Arithematic Operators ---
@@ -480,6 +530,10 @@ class mat4 {
 	return *this;
     }
 
+#ifdef ANGEL_SSE
+    mat4& operator *= ( const mat4& m )
+	{ return *this = *this * m; }
+#else
     mat4& operator *= ( const mat4& m ) {
 	mat4  a( 0.0 );
 
@@ -493,6 +547,7 @@ class mat4 {
 
 	return *this = a;
     }
+#endif
 
     mat4& operator /= ( const GLfloat s ) {
 #ifdef DEBUG
@@ -511,6 +566,19 @@ class mat4 {
     //  --- Matrix / Vector operators ---
     //
 
+#ifdef ANGEL_SSE
+    // each row times v, then the four products transposed so that adding
+    //   their rows sums every product left to right, like the scalar code
+    vec4 operator * ( const vec4& v ) const {  // m * v
+	__m128 p = v.simd();
+	__m128 p0 = _mm_mul_ps( _m[0].simd(), p );
+	__m128 p1 = _mm_mul_ps( _m[1].simd(), p );
+	__m128 p2 = _mm_mul_ps( _m[2].simd(), p );
+	__m128 p3 = _mm_mul_ps( _m[3].simd(), p );
+	_MM_TRANSPOSE4_PS( p0, p1, p2, p3 );
+	return vec4( _mm_add_ps( _mm_add_ps( _mm_add_ps( p0, p1 ), p2 ), p3 ) );
+    }
+#else
     vec4 operator * ( const vec4& v ) const {  // m * v
 	return vec4( _m[0][0]*v.x + _m[0][1]*v.y + _m[0][2]*v.z + _m[0][3]*v.w,
 		     _m[1][0]*v.x + _m[1][1]*v.y + _m[1][2]*v.z + _m[1][3]*v.w,
@@ -518,6 +586,7 @@ class mat4 {
 		     _m[3][0]*v.x + _m[3][1]*v.y + _m[3][2]*v.z + _m[3][3]*v.w
 	    );
     }
+#endif
 	
     //
     //  --- Insertion and Extraction Operators ---
@@ -552,19 +621,30 @@ class mat4 {
 inline
 mat4 matrixCompMult( const mat4& A, const mat4& B ) {
     return mat4(
-	A[0][0]*B[0][0], A[0][1]*B[0][1], A[0][2]*B[0][2], A[0][3]*B[0][3],
-	A[1][0]*B[1][0], A[1][1]*B[1][1], A[1][2]*B[1][2], A[1][3]*B[1][3],
-	A[2][0]*B[2][0], A[2][1]*B[2][1], A[2][2]*B[2][2], A[2][3]*B[2][3],
-	A[3][0]*B[3][0], A[3][1]*B[3][1], A[3][2]*B[3][2], A[3][3]*B[3][3] );
+	vec4( A[0][0]*B[0][0], A[0][1]*B[0][1], A[0][2]*B[0][2], A[0][3]*B[0][3] ),
+	vec4( A[1][0]*B[1][0], A[1][1]*B[1][1], A[1][2]*B[1][2], A[1][3]*B[1][3] ),
+	vec4( A[2][0]*B[2][0], A[2][1]*B[2][1], A[2][2]*B[2][2], A[2][3]*B[2][3] ),
+	vec4( A[3][0]*B[3][0], A[3][1]*B[3][1], A[3][2]*B[3][2], A[3][3]*B[3][3] ) );
 }
 
+//  The 16 float constructor takes its entries column by column, so the
+//    rows are built as vectors here and in matrixCompMult()
+#ifdef ANGEL_SSE
+inline
+mat4 transpose( const mat4& A ) {
+    __m128 r0 = A[0].simd(), r1 = A[1].simd(), r2 = A[2].simd(), r3 = A[3].simd();
+    _MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+    return mat4( vec4( r0 ), vec4( r1 ), vec4( r2 ), vec4( r3 ) );
+}
+#else
 inline
 mat4 transpose( const mat4& A ) {
-    return mat4( A[0][0], A[1][0], A[2][0], A[3][0],
-		 A[0][1], A[1][1], A[2][1], A[3][1],
-		 A[0][2], A[1][2], A[2][2], A[3][2],
-		 A[0][3], A[1][3], A[2][3], A[3][3] );
+    return mat4( vec4( A[0][0], A[1][0], A[2][0], A[3][0] ),
+		 vec4( A[0][1], A[1][1], A[2][1], A[3][1] ),
+		 vec4( A[0][2], A[1][2], A[2][2], A[3][2] ),
+		 vec4( A[0][3], A[1][3], A[2][3], A[3][3] ) );
 }
+#endif
 
 //////////////////////////////////////////////////////////////////////////////
 //
@@ -589,6 +669,12 @@ vec4 mvmult( const mat4& a, const vec4& b )
     return c;
 }
 
+//----------------------------------------------------------------------------
+//
+//  The generators below build each row of their matrix once, as a vector,
+//    instead of filling in an identity matrix entry by entry
+//
+
 //----------------------------------------------------------------------------
 //
 //  Rotation matrix generators
@@ -598,36 +684,36 @@ inline
 mat4 RotateX( const GLfloat theta )
 {
     GLfloat angle = DegreesToRadians * theta;
+    GLfloat c = cos(angle), s = sin(angle);
 
-    mat4 c;
-    c[2][2] = c[1][1] = cos(angle);
-    c[2][1] = sin(angle);
-    c[1][2] = -c[2][1];
-    return c;
+    return mat4( vec4( 1.0, 0.0, 0.0, 0.0 ),
+		 vec4( 0.0,   c,  -s, 0.0 ),
+		 vec4( 0.0,   s,   c, 0.0 ),
+		 vec4( 0.0, 0.0, 0.0, 1.0 ) );
 }
 
 inline
 mat4 RotateY( const GLfloat theta )
 {
     GLfloat angle = DegreesToRadians * theta;
+    GLfloat c = cos(angle), s = sin(angle);
 
-    mat4 c;
-    c[2][2] = c[0][0] = cos(angle);
-    c[0][2] = sin(angle);
-    c[2][0] = -c[0][2];
-    return c;
+    return mat4( vec4(   c, 0.0,   s, 0.0 ),
+		 vec4( 0.0, 1.0, 0.0, 0.0 ),
+		 vec4(  -s, 0.0,   c, 0.0 ),
+		 vec4( 0.0, 0.0, 0.0, 1.0 ) );
 }
 
 inline
 mat4 RotateZ( const GLfloat theta )
 {
     GLfloat angle = DegreesToRadians * theta;
+    GLfloat c = cos(angle), s = sin(angle);
 
-    mat4 c;
-    c[0][0] = c[1][1] = cos(angle);
-    c[1][0] = sin(angle);
-    c[0][1] = -c[1][0];
-    return c;
+    return mat4( vec4(   c,  -s, 0.0, 0.0 ),
+		 vec4(   s,   c, 0.0, 0.0 ),
+		 vec4( 0.0, 0.0, 1.0, 0.0 ),
+		 vec4( 0.0, 0.0, 0.0, 1.0 ) );
 }
 
 //----------------------------------------------------------------------------
@@ -638,11 +724,10 @@ mat4 RotateZ( const GLfloat theta )
 inline
 mat4 Translate( const GLfloat x, const GLfloat y, const GLfloat z )
 {
-    mat4 c;
-    c[0][3] = x;
-    c[1][3] = y;
-    c[2][3] = z;
-    return c;
+    return mat4( vec4( 1.0, 0.0, 0.0,   x ),
+		 vec4( 0.0, 1.0, 0.0,   y ),
+		 vec4( 0.0, 0.0, 1.0,   z ),
+		 vec4( 0.0, 0.0, 0.0, 1.0 ) );
 }
 
 inline
@@ -665,11 +750,10 @@ mat4 Translate( const vec4& v )
 inline
 mat4 Scale( const GLfloat x, const GLfloat y, const GLfloat z )
 {
-    mat4 c;
-    c[0][0] = x;
-    c[1][1] = y;
-    c[2][2] = z;
-    return c;
+    return mat4( vec4(   x, 0.0, 0.0, 0.0 ),
+		 vec4( 0.0,   y, 0.0, 0.0 ),
+		 vec4( 0.0, 0.0,   z, 0.0 ),
+		 vec4( 0.0, 0.0, 0.0, 1.0 ) );
 }
 
 inline
@@ -735,13 +819,12 @@ mat4 Perspective( const GLfloat fovy, const GLfloat aspect,
     GLfloat top   = tan(fovy*DegreesToRadians/2) * zNear;
     GLfloat right = top * aspect;
 
-    mat4 c;
-    c[0][0] = zNear/right;
-    c[1][1] = zNear/top;
-    c[2][2] = -(zFar + zNear)/(zFar - zNear);
-    c[2][3] = -2.0*zFar*zNear/(zFar - zNear);
-    c[3][2] = -1.0;
-    return c;
+    // the last row keeps the 1 of the identity this used to be filled into
+    return mat4( vec4( zNear/right, 0.0, 0.0, 0.0 ),
+		 vec4( 0.0, zNear/top, 0.0, 0.0 ),
+		 vec4( 0.0, 0.0, -(zFar + zNear)/(zFar - zNear),
+		       -2.0*zFar*zNear/(zFar - zNear) ),
+		 vec4( 0.0, 0.0, -1.0, 1.0 ) );
 }
 
 //----------------------------------------------------------------------------
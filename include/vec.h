@@ -9,6 +9,19 @@
 
 #include "Angel.h"
 
+//  vec4 and the rows of mat4 are four packed floats, so with SSE (every x86-64
+//    compiler has it) they are worked on a whole vector at a time, and with AVX
+//    mat4 products two rows at a time.  Define ANGEL_NO_SIMD for plain scalar
+//    code everywhere.
+#if !defined(ANGEL_NO_SIMD) && (defined(__SSE__) || defined(_M_X64))
+#  define ANGEL_SSE
+#  include <xmmintrin.h>
+#  if defined(__AVX__)
+#    define ANGEL_AVX
+#    include <immintrin.h>
+#  endif
+#endif
+
 namespace Angel {
 
 //////////////////////////////////////////////////////////////////////////////
@@ -314,6 +327,21 @@ struct vec4 {
     //  --- Constructors and Destructors ---
     //
 
+#ifdef ANGEL_SSE
+    // stored as one vector, so that loading it back as one doesn't stall
+    vec4( GLfloat s = GLfloat(0.0) )
+	{ _mm_storeu_ps( &x, _mm_set1_ps( s ) ); }
+
+    vec4( GLfloat x, GLfloat y, GLfloat z, GLfloat w )
+	{ _mm_storeu_ps( &this->x, _mm_setr_ps( x, y, z, w ) ); }
+
+    vec4( const vec4& v ) { _mm_storeu_ps( &x, v.simd() ); }
+
+    explicit vec4( __m128 v ) { _mm_storeu_ps( &x, v ); }
+
+    // x, y, z and w as one SSE register
+    __m128 simd() const { return _mm_loadu_ps( &x ); }
+#else
     vec4( GLfloat s = GLfloat(0.0) ) :
 	x(s), y(s), z(s), w(s) {}
 
@@ -321,6 +349,7 @@ struct vec4 {
 	x(x), y(y), z(z), w(w) {}
 
     vec4( const vec4& v ) { x = v.x;  y = v.y;  z = v.z;  w = v.w; }
+#endif
 
     vec4( const vec3& v, const float w = 1.0 ) : w(w)
 	{ x = v.x;  y = v.y;  z = v.z; }
@@ -339,6 +368,19 @@ struct vec4 {
     //  --- (non-modifying) Arithematic Operators ---
     //
 
+#ifdef ANGEL_SSE
+    vec4 operator - () const  // unary minus operator
+	{ return vec4( _mm_xor_ps( simd(), _mm_set1_ps( -0.0f ) ) ); }
+
+    vec4 operator + ( const vec4& v ) const
+	{ return vec4( _mm_add_ps( simd(), v.simd() ) ); }
+
+    vec4 operator - ( const vec4& v ) const
+	{ return vec4( _mm_sub_ps( simd(), v.simd() ) ); }
+
+    vec4 operator * ( const GLfloat s ) const
+	{ return vec4( _mm_mul_ps( _mm_set1_ps( s ), simd() ) ); }
+#else
     vec4 operator - () const  // unary minus operator
 	{ return vec4( -x, -y, -z, -w ); }
 
@@ -350,6 +392,7 @@ struct vec4 {
 
     vec4 operator * ( const GLfloat s ) const
 	{ return vec4( s*x, s*y, s*z, s*w ); }
+#endif
 
     vec4 operator * ( const vec4& v ) const
 	{ return vec4( x*v.x, y*v.y, z*v.z, w*v.z ); }
@@ -374,6 +417,16 @@ struct vec4 {
     //  --- (modifying) Arithematic Operators ---
     //
 
+#ifdef ANGEL_SSE
+    vec4& operator += ( const vec4& v )
+	{ return *this = *this + v; }
+
+    vec4& operator -= ( const vec4& v )
+	{ return *this = *this - v; }
+
+    vec4& operator *= ( const GLfloat s )
+	{ return *this = *this * s; }
+#else
     vec4& operator += ( const vec4& v )
 	{ x += v.x;  y += v.y;  z += v.z;  w += v.w;  return *this; }
 
@@ -382,6 +435,7 @@ struct vec4 {
 
     vec4& operator *= ( const GLfloat s )
 	{ x *= s;  y *= s;  z *= s;  w *= s;  return *this; }
+#endif
 
     vec4& operator *= ( const vec4& v )
 	{ x *= v.x, y *= v.y, z *= v.z, w *= v.w;  return *this; }
@@ -0,0 +1,180 @@
+// fruittetris-matbench: times the Angel mat4/vec4 operations the game builds its transforms with against the scalar
+// mat.h and vec.h they replaced (kept in include/scalar), and checks that both give the same results. Build with
+// make bench, and with CFLAGS+=-mavx for the AVX products
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include "include/Angel.h"
+#include "include/scalar/mat.h"
+
+// inputs each operation runs over, so that nothing folds into a constant
+#define BENCH_INPUTS 1024
+
+using namespace std;
+
+template <typename Matrix> void add(Matrix &sum, const Matrix &m) { sum += m; }
+
+//-------------------------------------------------------------------------------------------------------------------
+// The robot arm's three part transforms and the board's MVP for one pose, the way the game builds them each frame
+template <typename Ops>
+typename Ops::Matrix frame(const Ops &ops, const typename Ops::Matrix &projection, const typename Ops::Matrix &view,
+	GLfloat lower, GLfloat upper) {
+	typedef typename Ops::Matrix Matrix;
+	Matrix vp = ops.multiply(projection, view);
+	Matrix m = ops.multiply(ops.translate(-10, 0, 0), ops.rotateY(0));
+	Matrix sum = ops.multiply(vp, ops.multiply(m, ops.multiply(ops.translate(0, 1, 0), ops.scale(5, 2, 5))));
+	m = ops.multiply(m, ops.multiply(ops.translate(0, 2, 0), ops.rotateZ(lower)));
+	add(sum, ops.multiply(vp, ops.multiply(m, ops.multiply(ops.translate(0, 6, 0), ops.scale(.5, 12, .5)))));
+	m = ops.multiply(m, ops.multiply(ops.translate(0, 12, 0), ops.rotateZ(upper)));
+	add(sum, ops.multiply(vp, ops.multiply(m, ops.multiply(ops.translate(0, 5.5, 0), ops.scale(.5, 11, .5)))));
+	Matrix model = ops.multiply(ops.translate(0, 10, 0), ops.scale(1.0/33, 1.0/33, 1.0/33));
+	add(sum, ops.multiply(vp, ops.multiply(model, ops.translate(-198, -363, 0))));
+	return sum;
+}
+
+// the operations of frame() from the scalar or the current headers
+struct ScalarOps {
+	typedef Scalar::mat4 Matrix;
+	Matrix multiply(const Matrix &l, const Matrix &r) const { return l * r; }
+	Matrix translate(GLfloat x, GLfloat y, GLfloat z) const { return Scalar::Translate(x, y, z); }
+	Matrix scale(GLfloat x, GLfloat y, GLfloat z) const { return Scalar::Scale(x, y, z); }
+	Matrix rotateY(GLfloat theta) const { return Scalar::RotateY(theta); }
+	Matrix rotateZ(GLfloat theta) const { return Scalar::RotateZ(theta); }
+};
+
+struct AngelOps {
+	typedef mat4 Matrix;
+	Matrix multiply(const Matrix &l, const Matrix &r) const { return l * r; }
+	Matrix translate(GLfloat x, GLfloat y, GLfloat z) const { return Translate(x, y, z); }
+	Matrix scale(GLfloat x, GLfloat y, GLfloat z) const { return Scale(x, y, z); }
+	Matrix rotateY(GLfloat theta) const { return RotateY(theta); }
+	Matrix rotateZ(GLfloat theta) const { return RotateZ(theta); }
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// What the operations are timed on, in both kinds of types
+struct Inputs {
+	mat4 a[BENCH_INPUTS], b[BENCH_INPUTS];
+	vec4 v[BENCH_INPUTS];
+	Scalar::mat4 scalarA[BENCH_INPUTS], scalarB[BENCH_INPUTS];
+	Scalar::vec4 scalarV[BENCH_INPUTS];
+	GLfloat angle[BENCH_INPUTS];
+};
+
+GLfloat largestDifference(const Scalar::mat4 &a, const mat4 &b) {
+	GLfloat d = 0;
+	for(int i = 0; i < 4; i++)
+		for(int j = 0; j < 4; j++) d = max(d, fabs(a[i][j] - b[i][j]));
+	return d;
+}
+
+GLfloat largestDifference(const Scalar::vec4 &a, const vec4 &b) {
+	GLfloat d = 0;
+	for(int i = 0; i < 4; i++) d = max(d, fabs(a[i] - b[i]));
+	return d;
+}
+
+// seconds on a monotonic clock
+double wallTime() {
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+// the sums of every result end up here, so that no call can be left out
+volatile GLfloat sink;
+
+// Runs before and after on every input rounds times over, printing ns per call of each and how far apart their
+// results ever are
+template <typename Before, typename After>
+void bench(const char *name, int rounds, Before before, After after) {
+	auto sumBefore = before(0);
+	auto sumAfter = after(0);
+	double start = wallTime();
+	for(int r = 0; r < rounds; r++)
+		for(int i = 0; i < BENCH_INPUTS; i++) add(sumBefore, before(i));
+	double beforeSeconds = wallTime() - start;
+	start = wallTime();
+	for(int r = 0; r < rounds; r++)
+		for(int i = 0; i < BENCH_INPUTS; i++) add(sumAfter, after(i));
+	double afterSeconds = wallTime() - start;
+	sink = largestDifference(sumBefore, sumAfter);
+
+	GLfloat difference = 0;
+	for(int i = 0; i < BENCH_INPUTS; i++) difference = max(difference, largestDifference(before(i), after(i)));
+	double calls = (double)rounds*BENCH_INPUTS;
+	cout << left << setw(14) << name << right << fixed << setprecision(2)
+		<< setw(10) << beforeSeconds*1e9/calls << setw(10) << afterSeconds*1e9/calls
+		<< setw(9) << beforeSeconds/afterSeconds << "x" << scientific << setprecision(1) << setw(12) << difference
+		<< endl;
+}
+
+int main(int argc, char **argv) {
+	int rounds = 2000;
+	for(int i = 1; i < argc; i++) {
+		if(!strcmp(argv[i], "-rounds") && i + 1 < argc) rounds = max(1, atoi(argv[++i]));
+		else {
+			cerr << "usage: " << argv[0] << " [-rounds N]" << endl;
+			return 1;
+		}
+	}
+
+	static Inputs in;
+	srand(1);
+	for(int i = 0; i < BENCH_INPUTS; i++) {
+		in.angle[i] = rand()%3600/10.0f - 180;
+		for(int r = 0; r < 4; r++) {
+			in.v[i][r] = rand()%2001/100.0f - 10;
+			for(int c = 0; c < 4; c++) {
+				in.scalarA[i][r][c] = in.a[i][r][c] = rand()%2001/100.0f - 10;
+				in.scalarB[i][r][c] = in.b[i][r][c] = rand()%2001/100.0f - 10;
+			}
+		}
+		for(int r = 0; r < 4; r++) in.scalarV[i][r] = in.v[i][r];
+	}
+	const mat4 projection = Perspective(45, 400.0/720, 10, 200);
+	const Scalar::mat4 scalarProjection = Scalar::Perspective(45, 400.0/720, 10, 200);
+	const vec4 at(0, 10, 0, 1), up(0, 1, 0, 0);
+	const Scalar::vec4 scalarAt(0, 10, 0, 1), scalarUp(0, 1, 0, 0);
+
+#if defined(ANGEL_AVX)
+	cout << "mat.h built with AVX" << endl;
+#elif defined(ANGEL_SSE)
+	cout << "mat.h built with SSE" << endl;
+#else
+	cout << "mat.h built scalar" << endl;
+#endif
+	cout << left << setw(14) << "operation" << right << setw(10) << "scalar ns" << setw(10) << "mat.h ns"
+		<< setw(10) << "speedup" << setw(12) << "max diff" << endl;
+
+	// transpose() isn't timed: the scalar one handed back its argument
+	bench("mat4 * mat4", rounds,
+		[&](int i) { return in.scalarA[i] * in.scalarB[i]; },
+		[&](int i) { return in.a[i] * in.b[i]; });
+	bench("mat4 * vec4", rounds,
+		[&](int i) { return in.scalarA[i] * in.scalarV[i]; },
+		[&](int i) { return in.a[i] * in.v[i]; });
+	bench("RotateZ", rounds,
+		[&](int i) { return Scalar::RotateZ(in.angle[i]); },
+		[&](int i) { return RotateZ(in.angle[i]); });
+	bench("Translate", rounds,
+		[&](int i) { return Scalar::Translate(in.v[i].x, in.v[i].y, in.v[i].z); },
+		[&](int i) { return Translate(in.v[i].x, in.v[i].y, in.v[i].z); });
+	bench("Scale", rounds,
+		[&](int i) { return Scalar::Scale(in.v[i].x, in.v[i].y, in.v[i].z); },
+		[&](int i) { return Scale(in.v[i].x, in.v[i].y, in.v[i].z); });
+	bench("Perspective", rounds,
+		[&](int i) { return Scalar::Perspective(45, 1 + in.angle[i]/360, 10, 200); },
+		[&](int i) { return Perspective(45, 1 + in.angle[i]/360, 10, 200); });
+	bench("LookAt", rounds,
+		[&](int i) { return Scalar::LookAt(Scalar::vec4(in.v[i].x, 10, 33, 1), scalarAt, scalarUp); },
+		[&](int i) { return LookAt(vec4(in.v[i].x, 10, 33, 1), at, up); });
+	bench("robot + board", rounds/10 + 1,
+		[&](int i) { return frame(ScalarOps(), scalarProjection, in.scalarB[i], in.angle[i], -in.angle[i]); },
+		[&](int i) { return frame(AngelOps(), projection, in.b[i], in.angle[i], -in.angle[i]); });
+	return 0;
+}
@@ -0,0 +1,112 @@
+#include <cmath>
+#include <algorithm>
+#include "motion.h"
+#include "scheduler.h"
+
+using namespace std;
+
+namespace robot {
+
+// seconds a joint takes to turn degrees from rest to rest as fast as it can: speeding up, cruising at JOINT_SPEED
+// if the turn is long enough to get there, and slowing down
+static float fastestTurn(GLfloat degrees) {
+	if(degrees >= JOINT_SPEED*JOINT_SPEED/JOINT_ACCEL) return degrees/JOINT_SPEED + JOINT_SPEED/JOINT_ACCEL;
+	return 2*sqrt(degrees/JOINT_ACCEL);
+}
+
+// degrees a joint turning degrees from rest to rest in time seconds has turned after t seconds, speeding up and
+// slowing down at JOINT_ACCEL for as long as it needs to make it on time
+static float turned(GLfloat degrees, float time, float t) {
+	if(t >= time) return degrees;
+	// degrees = JOINT_ACCEL*ramp*(time - ramp)
+	float ramp = (time - sqrt(max(0.0f, time*time - 4*degrees/JOINT_ACCEL)))/2;
+	if(t < ramp) return JOINT_ACCEL*t*t/2;
+	if(t < time - ramp) return JOINT_ACCEL*ramp*(t - ramp/2);
+	return degrees - JOINT_ACCEL*(time - t)*(time - t)/2;
+}
+
+void ArmTrajectory::start(const GLfloat *theta) {
+	for(int j = 0; j < NumAngles; j++) poses[0][j] = theta[j];
+	reach[0] = 0;
+	count = 1;
+}
+
+bool ArmTrajectory::add(GLfloat lower, GLfloat upper) {
+	if(count > MAX_ARM_WAYPOINTS) return false;
+	const GLfloat *from = poses[count - 1];
+	GLfloat *to = poses[count];
+	to[Base] = from[Base];
+	to[LowerArm] = lower - 360*floor((lower - from[LowerArm] + 180)/360);
+	to[UpperArm] = upper - 360*floor((upper - from[UpperArm] + 180)/360);
+	GLfloat degrees = max(fabs(to[LowerArm] - from[LowerArm]), fabs(to[UpperArm] - from[UpperArm]));
+	reach[count] = reach[count - 1] + (int)ceil(fastestTurn(degrees)*1000/TICK_MS);
+	count++;
+	return true;
+}
+
+void ArmTrajectory::at(int k, GLfloat *theta) const {
+	int i = 1;
+	while(i < count && k >= reach[i]) i++;
+	if(i == count) {
+		for(int j = 0; j < NumAngles; j++) theta[j] = poses[count - 1][j];
+		return;
+	}
+	const GLfloat *from = poses[i - 1], *to = poses[i];
+	GLfloat degrees = max(fabs(to[LowerArm] - from[LowerArm]), fabs(to[UpperArm] - from[UpperArm]));
+	float f = turned(degrees, (reach[i] - reach[i - 1])*TICK_MS/1000.0f, (k - reach[i - 1])*TICK_MS/1000.0f)/degrees;
+	for(int j = 0; j < NumAngles; j++) theta[j] = from[j] + f*(to[j] - from[j]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// whether the tile held with its centre in cell tip is above every column of the stack it covers
+static bool clearsStack(const Cell &tip, const TileFootprint &tile, const int *heights, int width) {
+	for(int c = 0; c <= tile.maxX - tile.minX; c++) {
+		int x = tip.x + tile.minX + c;
+		if(x >= 0 && x < width && tip.y + tile.bottom[c] < heights[x]) return false;
+	}
+	return true;
+}
+
+// whether the tile never moves into the stack on any tick of path; a tile that starts out in the stack may leave it
+static bool pathClears(const ArmGeometry &geometry, const ArmTrajectory &path, const TileFootprint &tile, const int *heights,
+	int width) {
+	GLfloat theta[NumAngles];
+	bool inStack = false;
+	for(int k = 0; k <= path.ticks(); k++) {
+		path.at(k, theta);
+		bool clear = clearsStack(getTip(geometry, theta), tile, heights, width);
+		if(k == 0) inStack = !clear;
+		else if(clear) inStack = false;
+		else if(!inStack) return false;
+	}
+	return !inStack;
+}
+
+bool planArmPath(const ArmGeometry &geometry, const GLfloat *theta, const Cell &target, const TileFootprint &tile,
+	const int *heights, int width, ArmTrajectory &path) {
+	GLfloat down[NumAngles];
+	if(!aimTip(geometry, target, theta, down)) return false;
+	path.start(theta);
+	path.add(down[LowerArm], down[UpperArm]);
+	if(pathClears(geometry, path, tile, heights, width)) return true;
+
+	// up from where the tip is, across at that row and down onto the target, trying higher rows until the tile is
+	// over the whole stack at them
+	Cell tip = getTip(geometry, theta);
+	int top = 0;
+	for(int x = 0; x < width; x++) top = max(top, heights[x]);
+	for(int row = max(tip.y, target.y) + 1; row <= top - tile.minY + 1; row++) {
+		GLfloat up[NumAngles], across[NumAngles];
+		if(!aimTip(geometry, Cell(tip.x, row), theta, up) || !aimTip(geometry, Cell(target.x, row), up, across)
+			|| !aimTip(geometry, target, across, down))
+			continue;
+		path.start(theta);
+		path.add(up[LowerArm], up[UpperArm]);
+		path.add(across[LowerArm], across[UpperArm]);
+		path.add(down[LowerArm], down[UpperArm]);
+		if(pathClears(geometry, path, tile, heights, width)) return true;
+	}
+	return false;
+}
+
+} // namespace robot
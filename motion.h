@@ -0,0 +1,48 @@
+#ifndef __MOTION_H__
+#define __MOTION_H__
+
+#include "arm.h"
+#include "bitboard.h"
+
+namespace robot {
+
+// how fast the joints turn at most, in degrees per second, and how fast they speed up and slow down, in degrees per
+// second squared
+const GLfloat JOINT_SPEED = 360;
+const GLfloat JOINT_ACCEL = 1800;
+// most poses a path goes through after the one it starts at
+#define MAX_ARM_WAYPOINTS 3
+
+// Joint angles of the lower and upper arm over time, through a few poses with a stop at each. Between two poses
+// both joints turn along a straight line in joint space: the joint with the furthest to go speeds up at JOINT_ACCEL
+// to at most JOINT_SPEED and slows down again to arrive at rest, and the other follows in step with it. Game code
+// samples the path once per tick, so every time is counted in ticks from the start of the path
+class ArmTrajectory {
+public:
+	ArmTrajectory() : count(0) {}
+
+	// starts a new path at the pose of theta
+	void start(const GLfloat *theta);
+	// adds a stop at lower and upper degrees, taking the short way round; false if the path is full
+	bool add(GLfloat lower, GLfloat upper);
+	// ticks until the path comes to rest at its last pose
+	int ticks() const { return count ? reach[count - 1] : 0; }
+	// the pose k ticks into the path, the last one from ticks() on
+	void at(int k, GLfloat *theta) const;
+
+private:
+	GLfloat poses[MAX_ARM_WAYPOINTS + 1][NumAngles];
+	int reach[MAX_ARM_WAYPOINTS + 1]; // tick each pose is reached
+	int count; // poses in the path, the start included
+};
+
+// Plans a path for the arm of geometry from the pose of theta to a pose with the tip in cell target, along
+// which a tile of footprint tile held at the tip stays clear of the stack on every tick. The stack is the height of
+// each of width columns (see GameState::getColumnHeight). When the straight way cuts through the stack the tile is
+// lifted over it first, as little as will do. False if no such path is found
+bool planArmPath(const ArmGeometry &geometry, const GLfloat *theta, const Cell &target, const TileFootprint &tile,
+	const int *heights, int width, ArmTrajectory &path);
+
+} // namespace robot
+
+#endif // __MOTION_H__
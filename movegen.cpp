@@ -0,0 +1,72 @@
+#include "movegen.h"
+
+using namespace std;
+
+ArmReach::ArmReach(const robot::ArmGeometry &geometry) {
+	for(int x = 0; x < MAX_BOARD_WIDTH; x++) cols[x] = 0;
+	robot::forEachPose(geometry, [&](const GLfloat *theta) {
+		Cell tip = robot::getTip(geometry, theta);
+		if(tip.x >= 0 && tip.x < MAX_BOARD_WIDTH && tip.y >= 0 && tip.y < ARM_REACH_ROWS)
+			cols[tip.x] |= 1ull << tip.y;
+	});
+}
+
+static_assert(MAX_BOARD_HEIGHT + 3*TILE_REACH < 64, "every row a tile can rest on is in the 64 bit masks");
+
+//-------------------------------------------------------------------------------------------------------------------
+// Works a column at a time: with free[x] having bit y set if cell (x,y) is free, the rows where a tile fits are the
+// AND of the free masks of its cells' columns, each shifted by the cell's offset. A tile rests on the rows where it
+// fits and doesn't fit one row lower, and can get there if the arm reaches any row of the run of rows it fits in
+// above that; the top run is the one above the stack
+template<class Size>
+int generatePlacements(const BasicBitboard<Size> &board, int shape, const ArmReach &reach, Placement *out) {
+	// rows above the board are free, the TILE_REACH rows below it are not; bit TILE_REACH + y is row y
+	const Size &size = board.size;
+	uint64_t free[Size::maxWidth];
+	for(int x = 0; x < size.width; x++) free[x] = ~0ull << (size.height + TILE_REACH);
+	for(int y = 0; y < size.height; y++) {
+		BoardRow empty = ~board.rows[y] & board.fullRow();
+		for(int x = 0; x < size.width; x++)
+			free[x] |= (uint64_t)(empty >> x & 1) << (y + TILE_REACH);
+	}
+
+	int n = 0;
+	int orientations = shape == TileShapeO ? 1 : MAX_TILE_ORIENTATIONS;
+	for(int r = 0; r < orientations; r++) {
+		const TileOrientation &o = tileOrientations.o[shape][r];
+		for(int x = -o.footprint.minX; x + o.footprint.maxX < size.width; x++) {
+			uint64_t fits = ~0ull;
+			for(int i = 0; i < 4; i++)
+				fits &= free[x + o.offsets[i].x] >> (o.offsets[i].y + TILE_REACH);
+			// the top 2*TILE_REACH rows of fits had free rows shifted out of them
+			uint64_t rests = fits & ~(fits << 1) & ~0ull >> 2*TILE_REACH;
+			uint64_t release = fits & reach.cols[x];
+			for(; rests; rests &= rests - 1) {
+				int y = lowestBit(rests);
+				uint64_t run = fits >> y;
+				run &= ~(run + 1);
+				if(release >> y & run)
+					out[n++] = Placement(r, Cell(x, y));
+			}
+		}
+	}
+	return n;
+}
+
+template<class Size>
+int generatePlacements(const BasicGameState<Size> &game, Placement *out) {
+	// every game of a size has the same arm, so each thread keeps the reach of the arm of the last size it saw
+	static thread_local ArmReach reach;
+	static thread_local int width = 0, height = 0;
+	if(game.width() != width || game.height() != height) {
+		reach = ArmReach(game.arm.getGeometry());
+		width = game.width();
+		height = game.height();
+	}
+	return generatePlacements(game.getBoard(), game.currTileShapeIndex, reach, out);
+}
+
+template int generatePlacements(const Bitboard &, int, const ArmReach &, Placement *);
+template int generatePlacements(const BasicBitboard<RuntimeBoardSize> &, int, const ArmReach &, Placement *);
+template int generatePlacements(const GameState &, Placement *);
+template int generatePlacements(const RuntimeGameState &, Placement *);
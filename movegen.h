@@ -0,0 +1,43 @@
+#ifndef __MOVEGEN_H__
+#define __MOVEGEN_H__
+
+#include <stdint.h>
+#include "game.h"
+
+// rows above the bottom of the board the tip of the arm is tracked up to
+#define ARM_REACH_ROWS 64
+
+// most placements one tile can have on a board of Size: every orientation in every column, resting on the stack or
+// in a hole
+template<class Size> constexpr int maxPlacements() {
+	return MAX_TILE_ORIENTATIONS*Size::maxWidth*((Size::maxHeight + 1)/2 + 1);
+}
+
+// Where a tile can come to rest: currTileRotation and currTilePos of the tile once it has landed
+struct Placement {
+	int rotation;
+	Cell pos;
+
+	Placement() : rotation(0) {}
+	Placement(int rotation, const Cell &pos) : rotation(rotation), pos(pos) {}
+};
+
+// Cells the tip of the arm of geometry can be steered over a joint step at a time; the tile is released from there.
+// cols[x] has bit y set if the tip reaches cell (x,y)
+struct ArmReach {
+	uint64_t cols[MAX_BOARD_WIDTH];
+
+	ArmReach() {}
+	explicit ArmReach(const robot::ArmGeometry &geometry);
+};
+
+// Fills out with every placement of shape a player could reach on board: the tile is held anywhere the arm reaches
+// with any orientation and falls straight down from where it is let go, so it can also end up in a hole under an
+// overhang. Turning the O piece only shuffles its colours, so it has one orientation. Returns the number of placements
+template<class Size>
+int generatePlacements(const BasicBitboard<Size> &board, int shape, const ArmReach &reach, Placement *out);
+// the placements of the game's current tile with the game's arm
+template<class Size>
+int generatePlacements(const BasicGameState<Size> &game, Placement *out);
+
+#endif // __MOVEGEN_H__
@@ -0,0 +1,125 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "include/Angel.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include "offscreen.h"
+
+using namespace std;
+
+static EGLDisplay display = EGL_NO_DISPLAY;
+static EGLSurface surface = EGL_NO_SURFACE;
+static EGLContext context = EGL_NO_CONTEXT;
+static GLuint fbo, renderbuffers[2];
+
+static bool hasExtension(const char *extensions, const char *name) {
+	if(extensions == NULL) return false;
+	size_t n = strlen(name);
+	for(const char *p = strstr(extensions, name); p != NULL; p = strstr(p + n, name))
+		if((p == extensions || p[-1] == ' ') && (p[n] == ' ' || p[n] == '\0')) return true;
+	return false;
+}
+
+// The surfaceless platform needs no device or display server at all; fall back to the default display
+static EGLDisplay getDisplay() {
+	const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	if(hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+		PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+			(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+		if(getPlatformDisplay != NULL) {
+			EGLDisplay d = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+			if(d != EGL_NO_DISPLAY && eglInitialize(d, NULL, NULL)) return d;
+		}
+	}
+	EGLDisplay d = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	if(d != EGL_NO_DISPLAY && eglInitialize(d, NULL, NULL)) return d;
+	return EGL_NO_DISPLAY;
+}
+
+bool createOffscreenContext(int width, int height) {
+	display = getDisplay();
+	if(display == EGL_NO_DISPLAY) { cerr << "Unable to initialize EGL" << endl; return false; }
+	bool surfaceless = hasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+
+	const EGLint configAttribs[] = {
+		EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+		EGL_NONE
+	};
+	EGLConfig config;
+	EGLint numConfigs = 0;
+	if(!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs < 1) {
+		cerr << "No EGL config for desktop GL" << endl;
+		return false;
+	}
+
+	// the game uses GL 3.3 features alongside the fixed function text, so ask for a compatibility profile first
+	const EGLint compatAttribs[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+		EGL_NONE
+	};
+	context = eglCreateContext(display, config, EGL_NO_CONTEXT, compatAttribs);
+	if(context == EGL_NO_CONTEXT) context = eglCreateContext(display, config, EGL_NO_CONTEXT, NULL);
+	if(context == EGL_NO_CONTEXT) { cerr << "Unable to create an EGL context" << endl; return false; }
+
+	if(!surfaceless) {
+		const EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+		surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+		if(surface == EGL_NO_SURFACE) { cerr << "Unable to create an EGL pbuffer" << endl; return false; }
+	}
+	if(!eglMakeCurrent(display, surface, surface, context)) { cerr << "Unable to make the EGL context current" << endl; return false; }
+
+	// everything is drawn into an FBO, the pbuffer (if any) is only there to make the context current
+	glGenFramebuffers(1, &fbo);
+	glGenRenderbuffers(2, renderbuffers);
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+	glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+	if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		cerr << "Offscreen framebuffer is incomplete" << endl;
+		return false;
+	}
+	glViewport(0, 0, width, height);
+	return true;
+}
+
+void destroyOffscreenContext() {
+	if(display == EGL_NO_DISPLAY) return;
+	if(context != EGL_NO_CONTEXT) {
+		glDeleteFramebuffers(1, &fbo);
+		glDeleteRenderbuffers(2, renderbuffers);
+	}
+	eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if(context != EGL_NO_CONTEXT) eglDestroyContext(display, context);
+	if(surface != EGL_NO_SURFACE) eglDestroySurface(display, surface);
+	eglTerminate(display);
+	display = EGL_NO_DISPLAY;
+	surface = EGL_NO_SURFACE;
+	context = EGL_NO_CONTEXT;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+bool saveScreenshot(const char *filename, int width, int height) {
+	vector<unsigned char> pixels(3*width*height);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, &pixels[0]);
+
+	FILE *fp = fopen(filename, "wb");
+	if(fp == NULL) { cerr << "Unable to write screenshot " << filename << endl; return false; }
+	fprintf(fp, "P6\n%d %d\n255\n", width, height);
+	// GL rows go bottom to top, PPM rows top to bottom
+	for(int y = height - 1; y >= 0; y--)
+		fwrite(&pixels[3*width*y], 1, 3*width, fp);
+	bool ok = !ferror(fp);
+	ok = fclose(fp) == 0 && ok;
+	if(!ok) cerr << "Failed writing screenshot " << filename << endl;
+	return ok;
+}
@@ -0,0 +1,14 @@
+#ifndef __OFFSCREEN_H__
+#define __OFFSCREEN_H__
+
+// Rendering without a window or an X server, e.g. on Mesa's software driver on a build agent.
+// Creates an EGL context, surfaceless if the driver supports it and on a pbuffer otherwise, and binds a
+// width x height framebuffer object in place of the default framebuffer. Prints the reason to stderr and
+// returns false on failure
+bool createOffscreenContext(int width, int height);
+void destroyOffscreenContext();
+
+// Writes the bound framebuffer as a binary PPM
+bool saveScreenshot(const char *filename, int width, int height);
+
+#endif // __OFFSCREEN_H__
@@ -0,0 +1,92 @@
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include "policy.h"
+
+// inputs a policy spends on one tile before it releases wherever the arm is
+#define MAX_POLICY_MOVES 40
+
+const char *policyNames[] = {"release", "random", "lowest", NULL};
+const char *policyHelp[] = {
+	"releases every tile where it spawns",
+	"moves the arm, rotates and shuffles at random, then releases",
+	"sends the arm over the lowest column and releases there",
+	NULL
+};
+
+template<class Game> InputPolicy<Game> *createPolicy(const char *name, uint64_t seed) {
+	if(!strcmp(name, "release")) return new ReleasePolicy<Game>();
+	if(!strcmp(name, "random")) return new RandomPolicy<Game>(seed);
+	if(!strcmp(name, "lowest")) return new LowestColumnPolicy<Game>();
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+template<class Game> GameInput ReleasePolicy<Game>::next(const Game &game) {
+	return game.canRelease() ? InputReleaseTile : InputNone;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+template<class Game> GameInput RandomPolicy<Game>::next(const Game &game) {
+	static const GameInput inputs[] = {
+		InputRotateTile, InputShuffleColours,
+		InputLowerArmCCW, InputLowerArmCW, InputUpperArmCCW, InputUpperArmCW
+	};
+	if(moves < 0 || tile != game.tilesPlaced) {
+		tile = game.tilesPlaced;
+		moves = rng.below(MAX_POLICY_MOVES);
+	}
+	if(moves > 0) {
+		moves--;
+		return inputs[rng.below(sizeof(inputs)/sizeof(inputs[0]))];
+	}
+	return game.canRelease() ? InputReleaseTile : InputNone;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+template<class Game> GameInput LowestColumnPolicy<Game>::next(const Game &game) {
+	static const GameInput inputs[] = {InputLowerArmCCW, InputLowerArmCW, InputUpperArmCCW, InputUpperArmCW};
+	static const int joints[] = {robot::LowerArm, robot::LowerArm, robot::UpperArm, robot::UpperArm};
+	const robot::Arm &arm = game.arm;
+	GLfloat step = arm.getGeometry().jointStep;
+	const GLfloat steps[] = {step, -step, step, -step};
+	if(moves < 0 || tile != game.tilesPlaced) {
+		tile = game.tilesPlaced;
+		moves = 0;
+		// the lowest column, leftmost first, and the height of the stack
+		target = 0, highest = 0;
+		int lowest = game.height() + 1;
+		for(int x = 0; x < game.width(); x++) {
+			int h = game.getColumnHeight(x);
+			if(h < lowest) { lowest = h; target = x; }
+			highest = std::max(highest, h);
+		}
+		// with the tip over the column and the tile above the stack, high enough that the next tile, which appears at
+		// the tip, mostly clears this one once it has landed
+		this->goal = Cell(target, highest + 2*TILE_REACH + 1);
+		return InputArmGoal;
+	}
+	if(game.isArmMoving()) return InputNone;
+
+	Cell tip = arm.getTip();
+	if(game.canRelease() && (tip.x == target || moves >= MAX_POLICY_MOVES)) return InputReleaseTile;
+	if(moves >= MAX_POLICY_MOVES) return InputNone; // the gripper times out and drops the tile
+	moves++;
+
+	// the arm step that brings the tip closest to the column while keeping it above the stack
+	GameInput best = InputNone;
+	float bestCost = abs(tip.x - target) + (tip.y <= highest ? game.width() : 0);
+	for(int k = 0; k < 4; k++) {
+		GLfloat theta[robot::NumAngles];
+		memcpy(theta, arm.getTheta(), sizeof(theta));
+		theta[joints[k]] += steps[k];
+		Cell t = robot::getTip(arm.getGeometry(), theta);
+		float cost = abs(t.x - target) + (t.y <= highest ? game.width() : 0);
+		if(cost < bestCost) { bestCost = cost; best = inputs[k]; }
+	}
+	if(best == InputNone && game.canRelease()) return InputReleaseTile;
+	return best;
+}
+
+template InputPolicy<GameState> *createPolicy(const char *name, uint64_t seed);
+template InputPolicy<RuntimeGameState> *createPolicy(const char *name, uint64_t seed);
@@ -0,0 +1,58 @@
+#ifndef __POLICY_H__
+#define __POLICY_H__
+
+#include "game.h"
+#include "rng.h"
+
+// Plays a headless game in place of a player. Drivers ask for one input each tick while the tile is held by the
+// arm; a policy belongs to one game, so it may keep state between calls. Game is GameState or RuntimeGameState
+template<class Game> class InputPolicy {
+public:
+	// where InputArmGoal sends the arm, given to the game along with it
+	Cell goal;
+
+	virtual ~InputPolicy() {}
+	// the input to give the game now, InputNone to wait
+	virtual GameInput next(const Game &game) = 0;
+};
+
+// Names createPolicy() knows, with a line describing each
+extern const char *policyNames[];
+extern const char *policyHelp[];
+
+// New policy by name drawing any random choices from seed, NULL if there is no such policy
+template<class Game> InputPolicy<Game> *createPolicy(const char *name, uint64_t seed);
+
+//-------------------------------------------------------------------------------------------------------------------
+// Releases every tile where it spawns, as soon as it can
+template<class Game> class ReleasePolicy : public InputPolicy<Game> {
+public:
+	GameInput next(const Game &game);
+};
+
+// Swings the arm, rotates and shuffles at random for a random number of ticks, then releases
+template<class Game> class RandomPolicy : public InputPolicy<Game> {
+public:
+	RandomPolicy(uint64_t seed) : rng(seed), moves(-1), tile(0) {}
+	GameInput next(const Game &game);
+
+private:
+	Rng rng;
+	int moves; // inputs left before releasing the current tile, -1 before the first tile is seen
+	uint32_t tile; // tilesPlaced when the current tile was seen
+};
+
+// Sends the arm over the lowest column, above the stack, with one InputArmGoal and releases once it's there; if
+// the game can't plan the way there it steps whichever way brings the tip closest to the column
+template<class Game> class LowestColumnPolicy : public InputPolicy<Game> {
+public:
+	LowestColumnPolicy() : moves(-1), tile(0), target(0), highest(0) {}
+	GameInput next(const Game &game);
+
+private:
+	int moves; // inputs spent on the current tile, to give up on columns the arm can't reach; -1 before the first
+	uint32_t tile; // tilesPlaced when the current tile was seen
+	int target, highest; // the column steered to and the height of the stack
+};
+
+#endif // __POLICY_H__
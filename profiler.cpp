@@ -0,0 +1,137 @@
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include "profiler.h"
+
+using namespace std;
+
+const char *profileStageNames[MaxProfileStages] = {"robot", "board", "tile", "grid", "fade", "upload", "text", "frame"};
+
+// seconds on a monotonic clock
+static double now() {
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+Profiler::Profiler() : keepAll(false), gpu(false), frame(0) {
+	frames.resize(PROFILE_WINDOW);
+}
+
+void Profiler::init(bool g, bool k) {
+	gpu = g;
+	keepAll = k;
+	frame = 0;
+	frames.clear();
+	if(!keepAll) frames.resize(PROFILE_WINDOW);
+	memset(issued, 0, sizeof(issued));
+	if(gpu) glGenQueries(PROFILE_LATENCY*MaxProfileStages*2, &queries[0][0][0]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+void Profiler::beginFrame() {
+	int slot = frame % PROFILE_LATENCY;
+	// the queries of this slot were issued PROFILE_LATENCY frames ago and are about to be reused
+	if(gpu) collect(slot, frame - PROFILE_LATENCY);
+	if(keepAll) frames.push_back(FrameSample());
+	FrameSample &f = sample(frame);
+	for(int s = 0; s < MaxProfileStages; s++) f.cpu[s] = f.gpu[s] = -1;
+}
+
+void Profiler::endFrame() {
+	frame++;
+}
+
+void Profiler::begin(ProfileStage s) {
+	cpuStart[s] = now();
+	if(gpu) glQueryCounter(queries[frame % PROFILE_LATENCY][s][0], GL_TIMESTAMP);
+}
+
+void Profiler::end(ProfileStage s) {
+	sample(frame).cpu[s] = (now() - cpuStart[s])*1e6;
+	if(gpu) {
+		int slot = frame % PROFILE_LATENCY;
+		glQueryCounter(queries[slot][s][1], GL_TIMESTAMP);
+		issued[slot][s] = true;
+	}
+}
+
+// reads back the timestamps of frame f from slot; results that still aren't ready are dropped rather than waited on
+void Profiler::collect(int slot, int f) {
+	for(int s = 0; s < MaxProfileStages; s++) {
+		if(!issued[slot][s]) continue;
+		issued[slot][s] = false;
+		GLuint available = 0;
+		glGetQueryObjectuiv(queries[slot][s][1], GL_QUERY_RESULT_AVAILABLE, &available);
+		if(!available || f < 0) continue;
+		GLuint64 t0, t1;
+		glGetQueryObjectui64v(queries[slot][s][0], GL_QUERY_RESULT, &t0);
+		glGetQueryObjectui64v(queries[slot][s][1], GL_QUERY_RESULT, &t1);
+		sample(f).gpu[s] = (t1 - t0)/1000.0;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+// nearest rank percentile of the samples of frames first to last
+float Profiler::percentile(ProfileStage s, float p, bool gpuSamples, int first, int last) const {
+	vector<float> v;
+	for(int f = max(first, 0); f <= last; f++) {
+		const FrameSample &fs = frames[keepAll ? f : f % PROFILE_WINDOW];
+		float t = gpuSamples ? fs.gpu[s] : fs.cpu[s];
+		if(t >= 0) v.push_back(t);
+	}
+	if(v.empty()) return -1;
+	int rank = max(0, min((int)v.size() - 1, (int)ceil(p/100*v.size()) - 1));
+	nth_element(v.begin(), v.begin() + rank, v.end());
+	return v[rank];
+}
+
+float Profiler::cpuPercentile(ProfileStage s, float p) const {
+	return percentile(s, p, false, frame - PROFILE_WINDOW, frame - 1);
+}
+
+float Profiler::gpuPercentile(ProfileStage s, float p) const {
+	return percentile(s, p, true, frame - PROFILE_WINDOW, frame - 1);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+bool Profiler::save(const char *filename) const {
+	FILE *fp = fopen(filename, "w");
+	if(fp == NULL) { cerr << "Unable to write profile " << filename << endl; return false; }
+	int first = keepAll ? 0 : max(0, frame - PROFILE_WINDOW), last = frame - 1;
+
+	size_t len = strlen(filename);
+	if(len >= 5 && !strcmp(filename + len - 5, ".json")) {
+		static const float ps[] = {50, 95, 99, 100};
+		static const char *pnames[] = {"p50", "p95", "p99", "max"};
+		fprintf(fp, "{\n\t\"frames\": %d,\n\t\"stages\": {\n", last - first + 1);
+		for(int s = 0; s < MaxProfileStages; s++) {
+			fprintf(fp, "\t\t\"%s\": {", profileStageNames[s]);
+			for(int g = 0; g < 2; g++) {
+				fprintf(fp, "%s\"%s_us\": {", g ? ", " : "", g ? "gpu" : "cpu");
+				for(int i = 0; i < 4; i++)
+					fprintf(fp, "%s\"%s\": %.1f", i ? ", " : "", pnames[i], percentile((ProfileStage)s, ps[i], g, first, last));
+				fprintf(fp, "}");
+			}
+			fprintf(fp, "}%s\n", s + 1 < MaxProfileStages ? "," : "");
+		}
+		fprintf(fp, "\t}\n}\n");
+	} else {
+		fprintf(fp, "frame,stage,cpu_us,gpu_us\n");
+		for(int f = first; f <= last; f++) {
+			const FrameSample &fs = frames[keepAll ? f : f % PROFILE_WINDOW];
+			for(int s = 0; s < MaxProfileStages; s++)
+				if(fs.cpu[s] >= 0) fprintf(fp, "%d,%s,%.1f,%.1f\n", f, profileStageNames[s], fs.cpu[s], fs.gpu[s]);
+		}
+	}
+
+	bool ok = !ferror(fp);
+	ok = fclose(fp) == 0 && ok;
+	if(!ok) cerr << "Failed writing profile " << filename << endl;
+	return ok;
+}
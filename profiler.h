@@ -0,0 +1,79 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <vector>
+#include <string>
+#include "include/Angel.h"
+
+// frames the rolling summary covers
+#define PROFILE_WINDOW 120
+// frames a GL timer query is given before it is read back, so reading it never stalls the pipeline
+#define PROFILE_LATENCY 4
+
+// The stages of display() that are timed
+enum ProfileStage {
+	StageRobot,  // robot matrix stack and draws
+	StageBoard,  // board draw
+	StageTile,   // current tile draw
+	StageGrid,   // grid lines draw
+	StageFade,   // removed cell and game over fade animations
+	StageUpload, // updateBoard()
+	StageText,   // HUD text
+	StageFrame,  // all of display() before the buffer swap
+	MaxProfileStages
+};
+extern const char *profileStageNames[MaxProfileStages];
+
+// Per stage CPU timers, and GL timestamp queries when the GL has them. Samples are in microseconds,
+// -1 when a stage wasn't timed in a frame
+class Profiler {
+public:
+	Profiler();
+
+	// gpu enables GL timer queries, which needs a current context; keepAll keeps every frame for save()
+	// instead of only the last PROFILE_WINDOW
+	void init(bool gpu, bool keepAll);
+
+	void beginFrame();
+	void endFrame();
+	void begin(ProfileStage s);
+	void end(ProfileStage s);
+
+	// p-th percentile (0 to 100) of the stage over the last PROFILE_WINDOW frames, -1 without samples
+	float cpuPercentile(ProfileStage s, float p) const;
+	float gpuPercentile(ProfileStage s, float p) const;
+	bool hasGpu() const { return gpu; }
+	int frameCount() const { return frame; }
+
+	// Writes every kept frame as CSV (frame,stage,cpu_us,gpu_us), or a percentile summary of them as JSON if
+	// filename ends in .json; prints the reason to stderr and returns false on failure
+	bool save(const char *filename) const;
+
+private:
+	struct FrameSample {
+		float cpu[MaxProfileStages];
+		float gpu[MaxProfileStages];
+	};
+	std::vector<FrameSample> frames;
+	bool keepAll, gpu;
+	int frame;
+
+	double cpuStart[MaxProfileStages];
+	// begin and end timestamp of every stage for the last PROFILE_LATENCY frames
+	GLuint queries[PROFILE_LATENCY][MaxProfileStages][2];
+	bool issued[PROFILE_LATENCY][MaxProfileStages];
+
+	FrameSample &sample(int f) { return frames[keepAll ? f : f % PROFILE_WINDOW]; }
+	void collect(int slot, int f);
+	float percentile(ProfileStage s, float p, bool gpuSamples, int first, int last) const;
+};
+
+// Times its enclosing block as stage s
+struct ProfileScope {
+	Profiler &profiler;
+	ProfileStage stage;
+	ProfileScope(Profiler &p, ProfileStage s) : profiler(p), stage(s) { profiler.begin(stage); }
+	~ProfileScope() { profiler.end(stage); }
+};
+
+#endif // __PROFILER_H__
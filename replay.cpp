@@ -0,0 +1,130 @@
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include "replay.h"
+
+using namespace std;
+
+static const char REPLAY_MAGIC[4] = {'F', 'T', 'R', 'P'};
+static const unsigned char REPLAY_VERSION = 1;
+
+void Replay::record(uint32_t tick, GameInput input, const Cell &goal) {
+	ReplayEvent e = {tick, input, goal};
+	events.push_back(e);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+static void putVarint(vector<unsigned char> &out, uint32_t v) {
+	while(v >= 0x80) { out.push_back((v & 0x7f) | 0x80); v >>= 7; }
+	out.push_back(v);
+}
+// small negative numbers stay short: 0, -1, 1, -2, ... are 0, 1, 2, 3, ...
+static void putZigzag(vector<unsigned char> &out, int v) {
+	putVarint(out, (uint32_t)v << 1 ^ (uint32_t)(v >> 31));
+}
+static void putLE(vector<unsigned char> &out, uint64_t v, int bytes) {
+	for(int i = 0; i < bytes; i++) out.push_back((v >> 8*i) & 0xff);
+}
+
+bool Replay::save(const char *filename) const {
+	vector<unsigned char> out(REPLAY_MAGIC, REPLAY_MAGIC + 4);
+	out.push_back(REPLAY_VERSION);
+	putLE(out, seed, 8);
+	out.push_back((rules.clearCells ? 1 : 0) | (rules.canLose ? 2 : 0));
+	out.push_back(width);
+	out.push_back(height);
+	putLE(out, events.size(), 4);
+	uint32_t last = 0;
+	for(size_t i = 0; i < events.size(); i++) {
+		putVarint(out, events[i].tick - last);
+		out.push_back(events[i].input);
+		if(events[i].input == InputArmGoal) {
+			putZigzag(out, events[i].goal.x);
+			putZigzag(out, events[i].goal.y);
+		}
+		last = events[i].tick;
+	}
+
+	FILE *fp = fopen(filename, "wb");
+	if(fp == NULL) { cerr << "Unable to write replay " << filename << endl; return false; }
+	bool ok = fwrite(&out[0], 1, out.size(), fp) == out.size();
+	ok = fclose(fp) == 0 && ok;
+	if(!ok) cerr << "Failed writing replay " << filename << endl;
+	return ok;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+// reads a varint at pos into v and moves pos past it; false if in ends first
+static bool getVarint(const vector<unsigned char> &in, size_t &pos, uint32_t &v) {
+	v = 0;
+	for(int shift = 0; ; shift += 7) {
+		if(pos >= in.size() || shift > 28) return false;
+		v |= (uint32_t)(in[pos] & 0x7f) << shift;
+		if(!(in[pos++] & 0x80)) return true;
+	}
+}
+
+bool Replay::load(const char *filename) {
+	FILE *fp = fopen(filename, "rb");
+	if(fp == NULL) { cerr << "Unable to open replay " << filename << endl; return false; }
+	vector<unsigned char> in;
+	unsigned char buf[4096];
+	size_t n;
+	while((n = fread(buf, 1, sizeof(buf), fp)) > 0) in.insert(in.end(), buf, buf + n);
+	fclose(fp);
+
+	size_t pos = 4 + 1 + 8 + 3 + 4;
+	if(in.size() < pos || memcmp(&in[0], REPLAY_MAGIC, 4) != 0 || in[4] != REPLAY_VERSION) {
+		cerr << filename << " is not a version " << (int)REPLAY_VERSION << " replay" << endl;
+		return false;
+	}
+	seed = 0;
+	for(int i = 0; i < 8; i++) seed |= (uint64_t)in[5 + i] << 8*i;
+	rules.clearCells = in[13] & 1;
+	rules.canLose = in[13] & 2;
+	width = in[14];
+	height = in[15];
+	if(width < 4 || width > MAX_BOARD_WIDTH || height < 4 || height > MAX_BOARD_HEIGHT) {
+		cerr << filename << " has a " << width << "x" << height << " board, which can't be played" << endl;
+		return false;
+	}
+	uint32_t count = 0;
+	for(int i = 0; i < 4; i++) count |= (uint32_t)in[16 + i] << 8*i;
+
+	events.clear();
+	uint32_t tick = 0;
+	for(uint32_t k = 0; k < count; k++) {
+		uint32_t delta;
+		if(!getVarint(in, pos, delta) || pos >= in.size() || in[pos] >= MaxGameInputs) {
+			cerr << filename << " is truncated" << endl;
+			return false;
+		}
+		tick += delta;
+		GameInput input = (GameInput)in[pos++];
+		uint32_t x = 0, y = 0;
+		if(input == InputArmGoal && (!getVarint(in, pos, x) || !getVarint(in, pos, y))) {
+			cerr << filename << " is truncated" << endl;
+			return false;
+		}
+		record(tick, input, Cell((int)(x >> 1 ^ -(x & 1)), (int)(y >> 1 ^ -(y & 1))));
+	}
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+template<class Size>
+void simulate(BasicGameState<Size> &game, const Replay &replay) {
+	assert(game.width() == replay.width && game.height() == replay.height);
+	game.rules = replay.rules;
+	game.reset(replay.seed);
+	for(size_t i = 0; i < replay.events.size(); i++) {
+		while(game.now() < replay.events[i].tick) game.tick();
+		game.step(replay.events[i].input, replay.events[i].goal);
+	}
+}
+
+template void simulate(GameState &game, const Replay &replay);
+template void simulate(RuntimeGameState &game, const Replay &replay);
@@ -0,0 +1,41 @@
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+#include <vector>
+#include <stdint.h>
+#include "game.h"
+
+// One input fed into GameState::step()
+struct ReplayEvent {
+	uint32_t tick; // game ticks (TICK_MS) since the game was started
+	GameInput input;
+	Cell goal; // of InputArmGoal
+};
+
+// Everything needed to play a game again: the seed it started with, the rules and board size it was played with and
+// every input it was given, in order. Replay files are little endian:
+//   "FTRP" | u8 version | u64 seed | u8 rules | u8 width | u8 height | u32 number of events | events
+// where rules has bit 0 set for GameRules::clearCells and bit 1 for GameRules::canLose, and each event is its tick
+// minus the previous event's tick as a LEB128 varint, followed by the input as one byte; InputArmGoal is followed by
+// the x and y of its goal, each a zigzag encoded varint
+class Replay {
+public:
+	uint64_t seed;
+	GameRules rules;
+	int width, height; // of the board
+	std::vector<ReplayEvent> events;
+
+	Replay(uint64_t s = 1) : seed(s), width(StandardBoardSize::width), height(StandardBoardSize::height) {}
+
+	void record(uint32_t tick, GameInput input, const Cell &goal = Cell());
+	// both print the reason to stderr and return false on failure
+	bool save(const char *filename) const;
+	bool load(const char *filename);
+};
+
+// Plays the replay into game as fast as possible, starting from the replay's seed and rules and ticking the game
+// up to each input's tick before applying it. game has to have the replay's board size
+template<class Size>
+void simulate(BasicGameState<Size> &game, const Replay &replay);
+
+#endif // __REPLAY_H__
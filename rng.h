@@ -0,0 +1,33 @@
+#ifndef __RNG_H__
+#define __RNG_H__
+
+#include <stdint.h>
+
+// Small seedable PRNG (xorshift64*), one per game so runs are reproducible and games don't share state
+class Rng {
+public:
+	Rng(uint64_t s = 1) { seed(s); }
+
+	void seed(uint64_t s) {
+		// splitmix64 the seed so that nearby seeds give unrelated sequences; state must never be 0
+		uint64_t z = s + 0x9E3779B97F4A7C15ull;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		state = (z ^ (z >> 31)) | 1;
+	}
+	uint32_t next() {
+		state ^= state >> 12;
+		state ^= state << 25;
+		state ^= state >> 27;
+		return (state * 0x2545F4914F6CDD1Dull) >> 32;
+	}
+	// uniform integer in [0, n)
+	int below(int n) {
+		return ((uint64_t)next() * (uint32_t)n) >> 32;
+	}
+
+private:
+	uint64_t state;
+};
+
+#endif // __RNG_H__
@@ -4,13 +4,8 @@
 using namespace std;
 
 namespace robot {
-GLuint vao;
-GLuint buffer;
-const int NumVertices = 36;
-point4 points[NumVertices];
-color4 colors[NumVertices];
 
-point4 vertices[8] = {
+const point4 vertices[8] = {
     point4( -0.5, -0.5,  0.5, 1.0 ),
     point4( -0.5,  0.5,  0.5, 1.0 ),
     point4(  0.5,  0.5,  0.5, 1.0 ),
@@ -22,7 +17,7 @@ point4 vertices[8] = {
 };
 
 // RGBA olors
-color4 vertex_colors[8] = {
+const color4 vertex_colors[8] = {
     color4( 0.0, 0.0, 0.0, 1.0 ),  // black
     color4( 1.0, 0.0, 0.0, 1.0 ),  // red
     color4( 1.0, 1.0, 0.0, 1.0 ),  // yellow
@@ -33,33 +28,33 @@ color4 vertex_colors[8] = {
     color4( 0.0, 1.0, 1.0, 1.0 )   // cyan
 };
 
+// two triangles of face a b c d, coloured with the colour of a
+void quad( point4 *points, color4 *colors, int &index, int a, int b, int c, int d ) {
+    colors[index] = vertex_colors[a]; points[index] = vertices[a]; index++;
+    colors[index] = vertex_colors[a]; points[index] = vertices[b]; index++;
+    colors[index] = vertex_colors[a]; points[index] = vertices[c]; index++;
+    colors[index] = vertex_colors[a]; points[index] = vertices[a]; index++;
+    colors[index] = vertex_colors[a]; points[index] = vertices[c]; index++;
+    colors[index] = vertex_colors[a]; points[index] = vertices[d]; index++;
+}
+
+// the NumVertices vertices of the unit cube
+void colorcube( point4 *points, color4 *colors ) {
+    int index = 0;
+    quad( points, colors, index, 1, 0, 3, 2 );
+    quad( points, colors, index, 2, 3, 7, 6 );
+    quad( points, colors, index, 3, 0, 4, 7 );
+    quad( points, colors, index, 6, 5, 1, 2 );
+    quad( points, colors, index, 4, 5, 6, 7 );
+    quad( points, colors, index, 5, 4, 0, 1 );
+}
+
+void Model::init( GLuint vPosition, GLuint vColor, GLint mvp ) {
+    locMVP = mvp;
+    point4 points[NumVertices];
+    color4 colors[NumVertices];
+    colorcube( points, colors );
 
-// Parameters controlling the size of the Robot's arm
-const GLfloat BASE_HEIGHT      = 2.0;
-const GLfloat BASE_WIDTH       = 5.0;
-const GLfloat LOWER_ARM_HEIGHT = 12.0;
-const GLfloat LOWER_ARM_WIDTH  = 0.5;
-const GLfloat UPPER_ARM_HEIGHT = 11.0;
-const GLfloat UPPER_ARM_WIDTH  = 0.5;
-
-vec3 pos;
-// Shader transformation matrices
-mat4  robotMVP;
-
-// Array of rotation angles (in degrees) for each rotation axis
-//enum { Base = 0, LowerArm = 1, UpperArm = 2, NumAngles = 3 };
-int      Axis = Base;
-GLfloat  Theta[NumAngles] = { 0.0 };
-
-// Menu option values
-const int  Quit = 4;
-
-int Index = 0;
-void init( void ) {
-	Index = 0;
-	pos = vec3(-10, 0, 0);
-    colorcube();
-    
     // Create a vertex array object
     glGenVertexArrays( 1, &vao );
     glBindVertexArray( vao );
@@ -67,83 +62,71 @@ void init( void ) {
     // Create and initialize a buffer object
     glGenBuffers( 1, &buffer );
     glBindBuffer( GL_ARRAY_BUFFER, buffer );
-    glBufferData( GL_ARRAY_BUFFER, sizeof(points) + sizeof(colors), NULL, GL_DYNAMIC_DRAW );
-    glBufferSubData( GL_ARRAY_BUFFER, 0, sizeof(points), points );
-    glBufferSubData( GL_ARRAY_BUFFER, sizeof(points), sizeof(colors), colors );
-
-    glEnableVertexAttribArray( vPosition );
-    glVertexAttribPointer( vPosition, 4, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(0) );
-
-    glEnableVertexAttribArray( vColor );
-	glVertexAttribPointer( vColor, 4, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(sizeof(points)) );
+    // positions followed by colours, in whichever vertex layout was picked
+    GLsizei colorsOffset = NumVertices*positionSize();
+    glBufferData( GL_ARRAY_BUFFER, colorsOffset + NumVertices*colourSize(), NULL, GL_DYNAMIC_DRAW );
+    bufferPositions( 0, NumVertices, points, PositionUnit );
+    positionPointer( vPosition, 0 );
+    // bufferColours() counts in colours from the start of the buffer
+    bufferColours( colorsOffset/colourSize(), NumVertices, colors );
+	colourPointer( vColor, colorsOffset );
     //glPolygonMode( GL_FRONT_AND_BACK, GL_LINE );
 }
 
-void quad( int a, int b, int c, int d ) {
-    colors[Index] = vertex_colors[a]; points[Index] = vertices[a]; Index++;
-    colors[Index] = vertex_colors[a]; points[Index] = vertices[b]; Index++;
-    colors[Index] = vertex_colors[a]; points[Index] = vertices[c]; Index++;
-    colors[Index] = vertex_colors[a]; points[Index] = vertices[a]; Index++;
-    colors[Index] = vertex_colors[a]; points[Index] = vertices[c]; Index++;
-    colors[Index] = vertex_colors[a]; points[Index] = vertices[d]; Index++;
-}
-
-void colorcube() {
-    quad( 1, 0, 3, 2 );
-    quad( 2, 3, 7, 6 );
-    quad( 3, 0, 4, 7 );
-    quad( 6, 5, 1, 2 );
-    quad( 4, 5, 6, 7 );
-    quad( 5, 4, 0, 1 );
-}
-
-vec2 getTip() {
-	vec2 tip;
-	// base
-	tip.x += pos.x/2;
-	tip.y += pos.y + BASE_HEIGHT;
-	// lower arm
-	tip.x += LOWER_ARM_HEIGHT * -sin(3.14159/180* Theta[LowerArm]);
-	tip.y += LOWER_ARM_HEIGHT * cos(-3.14159/180* Theta[LowerArm]);
-	// upper arm
-	tip.x += (UPPER_ARM_HEIGHT-0.5) * -cos(3.14159/180* (90 - Theta[LowerArm] - Theta[UpperArm]));
-	tip.y += (UPPER_ARM_HEIGHT-0.5) * sin(3.14159/180* (90 - Theta[LowerArm] - Theta[UpperArm]));
-	// round
-	tip.x = (int)(0.5 + tip.x);
-	tip.y = (int)(0.5 + tip.y);
-	
-	return tip;
-}
-
-void base(const mat4 &vp) {
-    mat4 instance = ( Translate( 0.0, 0.5 * BASE_HEIGHT, 0.0 ) *
-		 Scale( BASE_WIDTH,
-			BASE_HEIGHT,
-			BASE_WIDTH ) );
-
-    glUniformMatrix4fv( locMVP, 1, GL_TRUE, vp * robotMVP * instance );
-    glDrawArrays( GL_TRIANGLES, 0, NumVertices );
+void Model::draw( const mat4 &vp, const Arm &arm ) const {
+    glBindVertexArray( vao );
+    const mat4 *parts = arm.getPartTransforms();
+    for ( int i = 0; i < NumAngles; i++ ) {
+        glUniformMatrix4fv( locMVP, 1, GL_TRUE, vp * parts[i] );
+        glDrawArrays( GL_TRIANGLES, 0, NumVertices );
+    }
 }
 
-void lower_arm(const mat4 &vp) {
-    mat4 instance = ( Translate( 0.0, 0.5 * LOWER_ARM_HEIGHT, 0.0 ) *
-		      Scale( LOWER_ARM_WIDTH,
-			     LOWER_ARM_HEIGHT,
-			     LOWER_ARM_WIDTH ) );
-    
-    glUniformMatrix4fv( locMVP, 1, GL_TRUE, vp * robotMVP * instance );
-    glDrawArrays( GL_TRIANGLES, 0, NumVertices );
+void Model::initInstanced( GLuint program ) {
+    locVP = glGetUniformLocation( program, "VP" );
+    GLuint position = glGetAttribLocation( program, "vPosition" );
+    GLuint color = glGetAttribLocation( program, "vColor" );
+    GLuint part = glGetAttribLocation( program, "vPart" );
+    point4 points[NumVertices];
+    color4 colors[NumVertices];
+    colorcube( points, colors );
+
+    glGenVertexArrays( 1, &instancedVao );
+    glBindVertexArray( instancedVao );
+    glGenBuffers( 2, instancedBuffers );
+
+    // positions followed by colours, as floats
+    glBindBuffer( GL_ARRAY_BUFFER, instancedBuffers[0] );
+    glBufferData( GL_ARRAY_BUFFER, sizeof(points) + sizeof(colors), NULL, GL_STATIC_DRAW );
+    glBufferSubData( GL_ARRAY_BUFFER, 0, sizeof(points), points );
+    glBufferSubData( GL_ARRAY_BUFFER, sizeof(points), sizeof(colors), colors );
+    glVertexAttribPointer( position, 4, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(0) );
+    glEnableVertexAttribArray( position );
+    glVertexAttribPointer( color, 4, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(sizeof(points)) );
+    glEnableVertexAttribArray( color );
+
+    // one transform per part; a mat4 attribute takes four locations, one per column
+    glBindBuffer( GL_ARRAY_BUFFER, instancedBuffers[1] );
+    glBufferData( GL_ARRAY_BUFFER, NumAngles*sizeof(mat4), NULL, GL_DYNAMIC_DRAW );
+    for ( int c = 0; c < 4; c++ ) {
+        glVertexAttribPointer( part + c, 4, GL_FLOAT, GL_FALSE, sizeof(mat4), BUFFER_OFFSET(c*sizeof(vec4)) );
+        glVertexAttribDivisor( part + c, 1 );
+        glEnableVertexAttribArray( part + c );
+    }
 }
 
-void upper_arm(const mat4 &vp) {
-    mat4 instance = ( Translate( 0.0, 0.5 * UPPER_ARM_HEIGHT, 0.0 ) *
-		      Scale( UPPER_ARM_WIDTH,
-			     UPPER_ARM_HEIGHT,
-			     UPPER_ARM_WIDTH ) );
-
-    glUniformMatrix4fv( locMVP, 1, GL_TRUE, vp * robotMVP * instance );
-    glDrawArrays( GL_TRIANGLES, 0, NumVertices );
+void Model::drawInstanced( const mat4 &vp, const Arm &arm ) const {
+    // mat4 is stored row by row and the attribute is read column by column
+    const mat4 *parts = arm.getPartTransforms();
+    mat4 columns[NumAngles];
+    for ( int i = 0; i < NumAngles; i++ )
+        columns[i] = transpose( parts[i] );
+
+    glBindVertexArray( instancedVao );
+    glBindBuffer( GL_ARRAY_BUFFER, instancedBuffers[1] );
+    glBufferSubData( GL_ARRAY_BUFFER, 0, sizeof(columns), columns );
+    glUniformMatrix4fv( locVP, 1, GL_TRUE, vp );
+    glDrawArraysInstanced( GL_TRIANGLES, 0, NumVertices, NumAngles );
 }
 
-
 } // namespace robot
@@ -1,31 +1,46 @@
-#include "include/Angel.h"
+#ifndef __ROBOT_H__
+#define __ROBOT_H__
 
-extern GLuint locMVP;
-extern GLuint vPosition, vColor;
+#include "include/Angel.h"
+#include "arm.h"
+#include "vertexformat.h"
 
 namespace robot {
 
 typedef Angel::vec4 point4;
 typedef Angel::vec4 color4;
 
-extern vec3 pos;
-extern mat4 robotMVP;
-extern GLuint vao;
-extern const GLfloat BASE_HEIGHT;
-extern const GLfloat BASE_WIDTH;
-extern const GLfloat LOWER_ARM_HEIGHT;
-extern const GLfloat LOWER_ARM_WIDTH;
-extern const GLfloat UPPER_ARM_HEIGHT;
-extern const GLfloat UPPER_ARM_WIDTH;
-enum { Base = 0, LowerArm = 1, UpperArm = 2, NumAngles = 3 };
-extern GLfloat Theta[NumAngles];
-
-vec2 getTip();
-void init();
-void quad( int a, int b, int c, int d );
-void colorcube();
-void base(const mat4&);
-void upper_arm(const mat4&);
-void lower_arm(const mat4&);
+// packed positions of the unit cube are multiples of half a unit
+const GLfloat PositionUnit = 0.5;
+const int NumVertices = 36;
+
+// The robot arm drawn as a base and two arms, each a scaled unit cube. It only holds GL objects, one Model per
+// context; the pose of the arm comes from the game it is drawn for
+class Model {
+public:
+    Model() : vao(0), buffer(0), locMVP(-1), instancedVao(0), locVP(-1) {}
+
+    // uploads the cube for the program with attributes vPosition and vColor and uniform MVP at locMVP
+    void init( GLuint vPosition, GLuint vColor, GLint locMVP );
+    // draws arm with its cached part transforms; vp is projection * view
+    void draw( const mat4 &vp, const Arm &arm ) const;
+
+    // uploads the cube for the instanced program (GL 3.3), with attributes vPosition and vColor, the model transform
+    // of each part as the per instance attribute vPart and uniform VP
+    void initInstanced( GLuint program );
+    // draws arm in one instanced call, one instance per part, with the instanced program in use
+    void drawInstanced( const mat4 &vp, const Arm &arm ) const;
+
+private:
+    GLuint vao;
+    GLuint buffer;
+    GLint locMVP;
+
+    GLuint instancedVao;
+    GLuint instancedBuffers[2]; // the cube, then the part transforms
+    GLint locVP;
+};
 
 } // namespace robot
+
+#endif // __ROBOT_H__
@@ -0,0 +1,17 @@
+#version 130
+
+// one unit cube, drawn once per part of the robot arm
+in vec4 vPosition;
+in vec4 vColor;
+// per instance: the model transform of the part, a column per attribute
+in mat4 vPart;
+out vec4 color;
+
+uniform mat4 VP;
+
+void main() 
+{
+	gl_Position = VP * (vPart * vPosition);
+
+	color = vColor;	
+} 
@@ -0,0 +1,32 @@
+#include "scheduler.h"
+
+void Scheduler::reset() {
+	tick = 0;
+	clear();
+}
+
+void Scheduler::clear() {
+	queue = std::priority_queue<Entry, std::vector<Entry> >();
+	seq = 0;
+	for(int i = 0; i < MaxGameEvents; i++) due[i] = NOT_PENDING;
+}
+
+void Scheduler::schedule(GameEvent ev, int delay) {
+	Entry e = {tick + delay/TICK_MS, seq++, ev};
+	due[ev] = e.due;
+	dueSeq[ev] = e.seq;
+	queue.push(e);
+}
+
+bool Scheduler::pop(GameEvent &ev) {
+	while(!queue.empty() && queue.top().due <= tick) {
+		Entry e = queue.top();
+		queue.pop();
+		// skip entries that were replaced or cancelled since they were queued
+		if(due[e.ev] != e.due || dueSeq[e.ev] != e.seq) continue;
+		due[e.ev] = NOT_PENDING;
+		ev = e.ev;
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,62 @@
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+
+#include <queue>
+#include <vector>
+#include <stdint.h>
+
+// length of one fixed game tick; every game delay is a multiple of it
+#define TICK_MS 10
+
+// Timed events of a game. At most one event of each kind is pending at a time
+enum GameEvent {
+	EventDropTick,     // the falling tile moves down a row
+	EventFastDropTick, // the tile moves down a row while fast dropping
+	EventColumnCheck,  // columns above removed fruits move down a row
+	EventGripTimeout,  // the gripper lets go of the tile
+	EventArmMove,      // the arm follows its planned path one tick further
+	MaxGameEvents
+};
+
+// Priority queue of game events on a fixed timestep clock. Nothing happens between ticks, so the same
+// events fire in the same order whether the clock is advanced in real time or as fast as possible
+class Scheduler {
+public:
+	Scheduler() { reset(); }
+
+	// drops all events and sets the clock back to 0
+	void reset();
+	// drops all events, keeping the clock running
+	void clear();
+
+	uint32_t now() const { return tick; }
+	void advance() { tick++; }
+
+	// schedules ev to fire after delay milliseconds (rounded down to ticks), replacing any pending ev
+	void schedule(GameEvent ev, int delay);
+	void cancel(GameEvent ev) { due[ev] = NOT_PENDING; }
+	bool isPending(GameEvent ev) const { return due[ev] != NOT_PENDING; }
+	// milliseconds until ev fires, 0 if it is not pending
+	int timeLeft(GameEvent ev) const { return isPending(ev) ? (due[ev] - tick)*TICK_MS : 0; }
+
+	// takes the earliest event due by now, in the order they were scheduled for equal times;
+	// returns false when no event is due
+	bool pop(GameEvent &ev);
+
+private:
+	static const uint32_t NOT_PENDING = 0xffffffff;
+
+	struct Entry {
+		uint32_t due, seq;
+		GameEvent ev;
+		// std::priority_queue is a max heap, so the earliest entry has to compare greatest
+		bool operator<(const Entry &o) const { return due != o.due ? due > o.due : seq > o.seq; }
+	};
+	std::priority_queue<Entry, std::vector<Entry> > queue;
+	// tick each kind of event is due, entries in the queue that don't match are stale and skipped
+	uint32_t due[MaxGameEvents];
+	uint32_t dueSeq[MaxGameEvents];
+	uint32_t tick, seq;
+};
+
+#endif // __SCHEDULER_H__
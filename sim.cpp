@@ -0,0 +1,288 @@
+// fruittetris-sim: plays many independent headless games of FruitTetris across all cores, each driven by an input
+// policy, and reports placements per second, the distribution of final scores and how long placements took
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <tuple>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include "game.h"
+#include "movegen.h"
+#include "policy.h"
+#include "threadpool.h"
+
+using namespace std;
+
+// log2 buckets of placement latencies in microseconds, the last one taking everything longer
+#define LATENCY_BUCKETS 24
+// bins of the score histogram
+#define SCORE_BINS 10
+// width of the longest histogram bar
+#define BAR_WIDTH 40
+
+struct SimOptions {
+	int games;
+	int threads; // 0 for one per core
+	const char *policy;
+	uint64_t seed; // game i is seeded with seed + i
+	uint32_t placements; // a game stops after this many tiles land
+	uint32_t ticks; // or after this many game ticks
+	GameRules rules;
+	int width, height; // of the board; the standard board plays on GameState, any other on RuntimeGameState
+	bool checkMoves; // check generatePlacements() against a brute force search for every tile
+};
+
+// What one game did; each game writes only its own
+struct GameStats {
+	uint32_t placements;
+	uint32_t ticks;
+	uint32_t inputs; // given to the game, InputNone left out
+	float score;
+	bool over; // lost, with rules.canLose
+	uint32_t checked, mismatched; // tiles whose placements were checked with o.checkMoves, and those that differed
+	double seconds; // wall time the game took
+	// latency[0] counts placements that took less than 1 us, latency[i] those that took [2^(i-1), 2^i) us
+	uint64_t latency[LATENCY_BUCKETS];
+};
+
+// seconds on a monotonic clock
+double wallTime() {
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+int latencyBucket(double seconds) {
+	double us = seconds*1e6;
+	int b = 0;
+	while(b < LATENCY_BUCKETS - 1 && us >= 1) { us /= 2; b++; }
+	return b;
+}
+
+// Brute force counterpart of generatePlacements(): holds the current tile in every orientation at every cell the arm
+// reaches, lets it fall and collects where it lands. Returns true if both find the same placements
+template<class Size> bool checkPlacements(const BasicGameState<Size> &game, const ArmReach &reach) {
+	typedef tuple<int, int, int> Found; // rotation, x, y
+	const BasicBitboard<Size> &board = game.getBoard();
+	int shape = game.currTileShapeIndex;
+	vector<Found> found;
+	int orientations = shape == TileShapeO ? 1 : MAX_TILE_ORIENTATIONS;
+	for(int r = 0; r < orientations; r++) {
+		const TileFootprint &f = tileOrientations.o[shape][r].footprint;
+		for(int x = 0; x < game.width(); x++) {
+			if(!board.fitsColumns(f, x)) continue;
+			auto fits = [&](int y) { return y + f.minY >= 0 && !board.overlaps(f, x, y); };
+			for(int y = 0; y < ARM_REACH_ROWS; y++) {
+				if(!(reach.cols[x] >> y & 1) || !fits(y)) continue;
+				int rest = y;
+				while(fits(rest - 1)) rest--;
+				found.push_back(Found(r, x, rest));
+			}
+		}
+	}
+	sort(found.begin(), found.end());
+	found.erase(unique(found.begin(), found.end()), found.end());
+
+	Placement placements[maxPlacements<Size>()];
+	int n = generatePlacements(game, placements);
+	vector<Found> generated;
+	for(int i = 0; i < n; i++) generated.push_back(Found(placements[i].rotation, placements[i].pos.x, placements[i].pos.y));
+	sort(generated.begin(), generated.end());
+	return generated == found;
+}
+
+// Plays one game on a board of size until it has placed o.placements tiles, run o.ticks ticks or been lost
+template<class Size> void playGame(const SimOptions &o, const Size &size, uint64_t seed, GameStats &s) {
+	typedef BasicGameState<Size> Game;
+	memset(&s, 0, sizeof(s));
+	Game game(seed, o.rules, size);
+	InputPolicy<Game> *policy = createPolicy<Game>(o.policy, seed);
+	ArmReach reach;
+	if(o.checkMoves) reach = ArmReach(game.arm.getGeometry());
+	uint32_t checked = UINT32_MAX; // tilesPlaced when the placements were last checked
+	double start = wallTime(), last = start;
+	while(game.tilesPlaced < o.placements && game.now() < o.ticks && !game.gui[TextGG]) {
+		uint32_t placed = game.tilesPlaced;
+		game.tick();
+		if(!game.tileFalling) {
+			if(o.checkMoves && game.tilesPlaced != checked) {
+				checked = game.tilesPlaced;
+				s.checked++;
+				if(!checkPlacements(game, reach)) s.mismatched++;
+			}
+			GameInput input = policy->next(game);
+			if(input != InputNone) {
+				game.step(input, policy->goal);
+				s.inputs++;
+			}
+		}
+		if(game.tilesPlaced != placed) {
+			double t = wallTime();
+			s.latency[latencyBucket(t - last)]++;
+			last = t;
+		}
+	}
+	s.seconds = wallTime() - start;
+	s.placements = game.tilesPlaced;
+	s.ticks = game.now();
+	s.score = game.gui[TextScore];
+	s.over = game.gui[TextGG] != 0;
+	delete policy;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+void printBar(uint64_t n, uint64_t most) {
+	int w = most ? (int)(BAR_WIDTH*n/most) : 0;
+	cout << ' ' << string(w, '#') << string(BAR_WIDTH - w, ' ') << ' ' << n << endl;
+}
+
+void printScores(const vector<GameStats> &stats) {
+	vector<float> scores;
+	double sum = 0;
+	for(size_t i = 0; i < stats.size(); i++) {
+		scores.push_back(stats[i].score);
+		sum += stats[i].score;
+	}
+	sort(scores.begin(), scores.end());
+	int n = scores.size();
+	cout << "score: min " << scores[0] << "  p10 " << scores[n/10] << "  p50 " << scores[n/2]
+		 << "  p90 " << scores[n*9/10] << "  max " << scores[n - 1] << "  mean " << sum/n << endl;
+	if(scores[0] == scores[n - 1]) return;
+
+	float lo = scores[0], width = (scores[n - 1] - lo)/SCORE_BINS;
+	uint64_t bins[SCORE_BINS] = {0}, most = 0;
+	for(int i = 0; i < n; i++)
+		bins[min(SCORE_BINS - 1, (int)((scores[i] - lo)/width))]++;
+	for(int b = 0; b < SCORE_BINS; b++) most = max(most, bins[b]);
+	for(int b = 0; b < SCORE_BINS; b++) {
+		cout << "  " << setw(8) << lo + b*width << " - " << setw(8) << lo + (b + 1)*width;
+		printBar(bins[b], most);
+	}
+}
+
+void printLatencies(const vector<GameStats> &stats) {
+	uint64_t buckets[LATENCY_BUCKETS] = {0}, total = 0, most = 0;
+	for(size_t i = 0; i < stats.size(); i++)
+		for(int b = 0; b < LATENCY_BUCKETS; b++)
+			buckets[b] += stats[i].latency[b];
+	int first = LATENCY_BUCKETS, last = 0;
+	for(int b = 0; b < LATENCY_BUCKETS; b++) {
+		total += buckets[b];
+		most = max(most, buckets[b]);
+		if(buckets[b]) { first = min(first, b); last = b; }
+	}
+	if(!total) return;
+
+	// percentiles are the upper bound of the bucket they fall in
+	cout << "latency per placement:";
+	const int percentiles[] = {50, 90, 99};
+	for(int p = 0; p < 3; p++) {
+		uint64_t seen = 0;
+		int b = 0;
+		while(b < LATENCY_BUCKETS - 1 && (seen += buckets[b]) < total*percentiles[p]/100.0) b++;
+		cout << "  p" << percentiles[p] << " < " << (1u << b) << " us";
+	}
+	cout << endl;
+	for(int b = first; b <= last; b++) {
+		if(b == LATENCY_BUCKETS - 1) cout << "  >= " << setw(8) << (1u << (b - 1)) << " us";
+		else cout << "   < " << setw(8) << (1u << b) << " us";
+		printBar(buckets[b], most);
+	}
+}
+
+void usage() {
+	cerr << "usage: fruittetris-sim [-games N] [-threads N] [-policy NAME] [-seed N] [-placements N] [-ticks N]"
+		 << " [-board WxH] [-clear] [-lose] [-checkmoves]" << endl;
+	cerr << "boards are up to " << MAX_BOARD_WIDTH << 'x' << MAX_BOARD_HEIGHT << ", " << StandardBoardSize::width << 'x'
+		 << StandardBoardSize::height << " by default" << endl;
+	cerr << "policies:" << endl;
+	for(int i = 0; policyNames[i]; i++)
+		cerr << "  " << setw(8) << left << policyNames[i] << right << policyHelp[i] << endl;
+}
+
+int main(int argc, char **argv) {
+	SimOptions o;
+	o.games = 1000;
+	o.threads = 0;
+	o.policy = "release";
+	o.seed = 1;
+	o.placements = 200;
+	o.ticks = 1000000;
+	o.width = StandardBoardSize::width;
+	o.height = StandardBoardSize::height;
+	o.checkMoves = false;
+	for(int i = 1; i < argc; i++) {
+		bool hasValue = i + 1 < argc;
+		if(!strcmp(argv[i], "-clear")) o.rules.clearCells = true;
+		else if(!strcmp(argv[i], "-lose")) o.rules.canLose = true;
+		else if(!strcmp(argv[i], "-checkmoves")) o.checkMoves = true;
+		else if(hasValue && !strcmp(argv[i], "-games")) o.games = atoi(argv[++i]);
+		else if(hasValue && !strcmp(argv[i], "-threads")) o.threads = atoi(argv[++i]);
+		else if(hasValue && !strcmp(argv[i], "-policy")) o.policy = argv[++i];
+		else if(hasValue && !strcmp(argv[i], "-seed")) o.seed = strtoull(argv[++i], NULL, 10);
+		else if(hasValue && !strcmp(argv[i], "-placements")) o.placements = strtoul(argv[++i], NULL, 10);
+		else if(hasValue && !strcmp(argv[i], "-ticks")) o.ticks = strtoul(argv[++i], NULL, 10);
+		else if(hasValue && !strcmp(argv[i], "-board")) {
+			if(sscanf(argv[++i], "%dx%d", &o.width, &o.height) != 2) { usage(); return EXIT_FAILURE; }
+		}
+		else { usage(); return EXIT_FAILURE; }
+	}
+	InputPolicy<GameState> *check = createPolicy<GameState>(o.policy, 0);
+	if(!check || o.games <= 0) { usage(); return EXIT_FAILURE; }
+	delete check;
+	// the widest tile has to fit across the board
+	if(o.width < 4 || o.width > MAX_BOARD_WIDTH || o.height < 4 || o.height > MAX_BOARD_HEIGHT) { usage(); return EXIT_FAILURE; }
+	bool standard = o.width == StandardBoardSize::width && o.height == StandardBoardSize::height;
+
+	vector<GameStats> stats(o.games);
+	double start, secs;
+	int threads;
+	{
+		ThreadPool pool(o.threads);
+		threads = pool.size();
+		start = wallTime();
+		for(int i = 0; i < o.games; i++) {
+			GameStats *s = &stats[i];
+			uint64_t seed = o.seed + i;
+			if(standard) pool.submit([&o, seed, s]() { playGame(o, StandardBoardSize(), seed, *s); });
+			else pool.submit([&o, seed, s]() { playGame(o, RuntimeBoardSize(o.width, o.height), seed, *s); });
+		}
+		pool.wait();
+		secs = wallTime() - start;
+	}
+
+	uint64_t placements = 0, ticks = 0, inputs = 0;
+	int over = 0;
+	uint64_t checked = 0, mismatched = 0;
+	double gameSecs = 0;
+	for(int i = 0; i < o.games; i++) {
+		placements += stats[i].placements;
+		ticks += stats[i].ticks;
+		inputs += stats[i].inputs;
+		over += stats[i].over;
+		checked += stats[i].checked;
+		mismatched += stats[i].mismatched;
+		gameSecs += stats[i].seconds;
+	}
+	cout << o.games << " games of policy " << o.policy << " on " << o.width << 'x' << o.height << " boards on " << threads
+		 << " threads in " << secs << " s";
+	if(o.rules.clearCells) cout << ", clearing cells";
+	if(o.rules.canLose) cout << ", " << over << " lost";
+	cout << endl;
+	cout << "placements: " << placements << "  " << placements/secs << " /s  " << placements/gameSecs
+		 << " /s per thread  " << (double)placements/o.games << " per game" << endl;
+	cout << "ticks: " << ticks << "  " << ticks/secs << " /s" << endl;
+	cout << "inputs: " << inputs << "  " << (placements ? (double)inputs/placements : 0) << " per placement" << endl;
+	printScores(stats);
+	printLatencies(stats);
+	if(o.checkMoves) {
+		cout << "moves: placements of " << checked << " tiles checked against a brute force search, " << mismatched
+			 << " differ" << endl;
+		if(mismatched) return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
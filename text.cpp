@@ -0,0 +1,135 @@
+#include <cstddef>
+#include <cmath>
+#include "text.h"
+#include "font.h"
+#include "vertexformat.h"
+
+using namespace std;
+
+// the atlas is a grid of ATLAS_COLUMNS glyph cells, with a pixel between cells so neighbours never bleed in
+#define ATLAS_COLUMNS 16
+#define ATLAS_ROWS ((FONT_CHARS + ATLAS_COLUMNS - 1)/ATLAS_COLUMNS)
+#define ATLAS_CELL_WIDTH (FONT_MAX_WIDTH + 1)
+#define ATLAS_CELL_HEIGHT (FONT_HEIGHT + 1)
+#define ATLAS_WIDTH (ATLAS_COLUMNS*ATLAS_CELL_WIDTH)
+#define ATLAS_HEIGHT (ATLAS_ROWS*ATLAS_CELL_HEIGHT)
+
+void TextRenderer::init(int numSlots) {
+	slots.assign(numSlots, Slot());
+	for(int i = 0; i < numSlots; i++) {
+		slots[i].x = slots[i].y = 0;
+		slots[i].colour = vec4(0, 0, 0, 0);
+	}
+
+	// one byte of coverage per texel, rows bottom to top like the font
+	vector<GLubyte> atlas(ATLAS_WIDTH*ATLAS_HEIGHT, 0);
+	for(int c = 0; c < FONT_CHARS; c++) {
+		int cellX = (c % ATLAS_COLUMNS)*ATLAS_CELL_WIDTH, cellY = (c / ATLAS_COLUMNS)*ATLAS_CELL_HEIGHT;
+		for(int y = 0; y < FONT_HEIGHT; y++)
+			for(int x = 0; x < fontGlyphs[c].width; x++)
+				if(fontGlyphs[c].rows[y] & (1u << x)) atlas[ATLAS_WIDTH*(cellY + y) + cellX + x] = 255;
+	}
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_WIDTH, ATLAS_HEIGHT, 0, GL_RED, GL_UNSIGNED_BYTE, &atlas[0]);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	program = InitShader("textvshader.glsl", "textfshader.glsl");
+	glUseProgram(program);
+	glUniform1i(glGetUniformLocation(program, "atlas"), 0);
+
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	GLuint vPosition = glGetAttribLocation(program, "vPosition");
+	GLuint vTexCoord = glGetAttribLocation(program, "vTexCoord");
+	GLuint vColor = glGetAttribLocation(program, "vColor");
+	glVertexAttribPointer(vPosition, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), BUFFER_OFFSET(offsetof(Vertex, x)));
+	glEnableVertexAttribArray(vPosition);
+	glVertexAttribPointer(vTexCoord, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), BUFFER_OFFSET(offsetof(Vertex, u)));
+	glEnableVertexAttribArray(vTexCoord);
+	glVertexAttribPointer(vColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), BUFFER_OFFSET(offsetof(Vertex, colour)));
+	glEnableVertexAttribArray(vColor);
+	capacity = 0;
+	dirty = true;
+}
+
+void TextRenderer::resize(int w, int h) {
+	if(w == width && h == height) return;
+	width = w;
+	height = h;
+	// pixel snapping depends on the size, so every slot has to be laid out again
+	for(size_t i = 0; i < slots.size(); i++) build(slots[i]);
+	dirty = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+void TextRenderer::set(int slot, const string &s, float x, float y, const vec4 &colour) {
+	Slot &sl = slots[slot];
+	if(sl.text == s && sl.x == x && sl.y == y && sl.colour.x == colour.x && sl.colour.y == colour.y
+		&& sl.colour.z == colour.z && sl.colour.w == colour.w) return;
+	sl.text = s;
+	sl.x = x;
+	sl.y = y;
+	sl.colour = colour;
+	build(sl);
+	dirty = true;
+}
+
+// lays out the two triangles of every glyph of s in pixels, then converts them to normalized device coordinates
+void TextRenderer::build(Slot &s) {
+	s.vertices.clear();
+	GLubyte colour[4];
+	packColour(s.colour, colour);
+	float penX = floor((s.x + 1)/2*width + 0.5f), baseY = floor((s.y + 1)/2*height + 0.5f) - FONT_DESCENT;
+	for(size_t i = 0; i < s.text.size(); i++) {
+		int c = (unsigned char)s.text[i] - FONT_FIRST_CHAR;
+		if(c < 0 || c >= FONT_CHARS) continue;
+		const FontGlyph &g = fontGlyphs[c];
+		float u0 = (float)(c % ATLAS_COLUMNS)*ATLAS_CELL_WIDTH/ATLAS_WIDTH, u1 = u0 + (float)g.width/ATLAS_WIDTH;
+		float v0 = (float)(c / ATLAS_COLUMNS)*ATLAS_CELL_HEIGHT/ATLAS_HEIGHT, v1 = v0 + (float)FONT_HEIGHT/ATLAS_HEIGHT;
+		float x0 = 2*penX/width - 1, x1 = 2*(penX + g.width)/width - 1;
+		float y0 = 2*baseY/height - 1, y1 = 2*(baseY + FONT_HEIGHT)/height - 1;
+		Vertex corners[4] = {{x0, y0, u0, v0}, {x1, y0, u1, v0}, {x0, y1, u0, v1}, {x1, y1, u1, v1}};
+		static const int order[6] = {0, 1, 2, 2, 1, 3};
+		for(int k = 0; k < 6; k++) {
+			Vertex v = corners[order[k]];
+			for(int j = 0; j < 4; j++) v.colour[j] = colour[j];
+			s.vertices.push_back(v);
+		}
+		penX += g.width;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+void TextRenderer::draw() {
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	if(dirty) {
+		batch.clear();
+		for(size_t i = 0; i < slots.size(); i++)
+			batch.insert(batch.end(), slots[i].vertices.begin(), slots[i].vertices.end());
+		if((int)batch.size() > capacity) {
+			capacity = 2*batch.size();
+			glBufferData(GL_ARRAY_BUFFER, capacity*sizeof(Vertex), NULL, GL_DYNAMIC_DRAW);
+		}
+		if(!batch.empty()) glBufferSubData(GL_ARRAY_BUFFER, 0, batch.size()*sizeof(Vertex), &batch[0]);
+		dirty = false;
+	}
+	if(batch.empty()) return;
+
+	glUseProgram(program);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	// text goes on top of everything, like the raster position text it replaces
+	glDisable(GL_DEPTH_TEST);
+	glDrawArrays(GL_TRIANGLES, 0, batch.size());
+	glEnable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,48 @@
+#ifndef __TEXT_H__
+#define __TEXT_H__
+
+#include <string>
+#include <vector>
+#include "include/Angel.h"
+
+// HUD text drawn from a glyph atlas that is rasterized once from the built-in font. Every string lives in a
+// numbered slot and its quads are only rebuilt when its text, position or colour changes; all slots share one
+// vertex buffer, re-uploaded only when a slot changed, and are drawn with a single call
+class TextRenderer {
+public:
+	TextRenderer() : width(1), height(1), capacity(0), dirty(true) {}
+
+	// builds the atlas, shaders and buffers for the given number of slots; needs a current context
+	void init(int numSlots);
+	// viewport size in pixels, glyphs are snapped to whole pixels
+	void resize(int w, int h);
+
+	// Shows s in slot with its baseline starting at (x,y) in normalized device coordinates, like glRasterPos2f
+	void set(int slot, const std::string &s, float x, float y, const vec4 &colour);
+	void hide(int slot) { set(slot, "", 0, 0, vec4(0, 0, 0, 0)); }
+
+	// draws every slot on top of whatever was drawn, leaving the text program in use
+	void draw();
+
+private:
+	struct Vertex {
+		GLfloat x, y, u, v;
+		GLubyte colour[4];
+	};
+	struct Slot {
+		std::string text;
+		float x, y;
+		vec4 colour;
+		std::vector<Vertex> vertices;
+	};
+	std::vector<Slot> slots;
+	GLuint program, vao, vbo, texture;
+	int width, height;
+	int capacity; // vertices vbo has room for
+	bool dirty; // some slot changed since the last upload
+	std::vector<Vertex> batch;
+
+	void build(Slot &s);
+};
+
+#endif // __TEXT_H__
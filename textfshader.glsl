@@ -0,0 +1,17 @@
+#version 130
+
+in  vec2 texCoord;
+in  vec4 color;
+out vec4  fColor;
+
+// glyph coverage, 0 or 1
+uniform sampler2D atlas;
+
+void main() 
+{ 
+	float coverage = texture(atlas, texCoord).r;
+	// discard if alpha is 0.0
+	if(coverage == 0.0 || color.w == 0.0)
+		discard;
+	fColor = vec4(color.xyz, color.w*coverage);
+} 
@@ -0,0 +1,15 @@
+#version 130
+
+// positions are already in normalized device coordinates
+in vec2 vPosition;
+in vec2 vTexCoord;
+in vec4 vColor;
+out vec2 texCoord;
+out vec4 color;
+
+void main() 
+{
+	gl_Position = vec4(vPosition, 0.0, 1.0);
+	texCoord = vTexCoord;
+	color = vColor;	
+} 
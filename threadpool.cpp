@@ -0,0 +1,77 @@
+#include "threadpool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(int threads) : nextQueue(0), pending(0), stopping(false) {
+	if(threads <= 0) threads = max(1u, thread::hardware_concurrency());
+	for(int i = 0; i < threads; i++)
+		queues.push_back(new Queue());
+	for(int i = 0; i < threads; i++)
+		workers.push_back(thread(&ThreadPool::run, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+	wait();
+	{
+		lock_guard<mutex> l(stateLock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for(size_t i = 0; i < workers.size(); i++)
+		workers[i].join();
+	for(size_t i = 0; i < queues.size(); i++)
+		delete queues[i];
+}
+
+void ThreadPool::submit(const function<void()> &task) {
+	{
+		lock_guard<mutex> l(stateLock);
+		pending++;
+		Queue &q = *queues[nextQueue++ % queues.size()];
+		lock_guard<mutex> ql(q.lock);
+		q.tasks.push_back(task);
+	}
+	wake.notify_all();
+}
+
+void ThreadPool::wait() {
+	unique_lock<mutex> l(stateLock);
+	while(pending > 0) idle.wait(l);
+}
+
+// the newest task of the worker's own queue, or else the oldest of the first other queue that has one
+bool ThreadPool::popTask(int self, function<void()> &task) {
+	int n = queues.size();
+	for(int k = 0; k < n; k++) {
+		Queue &q = *queues[(self + k) % n];
+		lock_guard<mutex> l(q.lock);
+		if(q.tasks.empty()) continue;
+		if(k == 0) { task = q.tasks.back(); q.tasks.pop_back(); }
+		else       { task = q.tasks.front(); q.tasks.pop_front(); }
+		return true;
+	}
+	return false;
+}
+
+void ThreadPool::run(int self) {
+	function<void()> task;
+	for(;;) {
+		if(popTask(self, task)) {
+			task();
+			task = function<void()>();
+			lock_guard<mutex> l(stateLock);
+			if(--pending == 0) idle.notify_all();
+			continue;
+		}
+		// nothing to run or steal: sleep until something is submitted; a task queued between popTask() and here
+		// is still seen, since submit() counts it under stateLock before notifying
+		unique_lock<mutex> l(stateLock);
+		if(stopping) return;
+		bool queued = false;
+		for(size_t k = 0; k < queues.size() && !queued; k++) {
+			lock_guard<mutex> ql(queues[k]->lock);
+			queued = !queues[k]->tasks.empty();
+		}
+		if(!queued) wake.wait(l);
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef __THREADPOOL_H__
+#define __THREADPOOL_H__
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Fixed set of worker threads, each with its own queue of tasks. A worker runs the newest task of its own queue and
+// steals the oldest task of another queue when its own runs dry, so uneven tasks (games of different lengths)
+// still keep every core busy
+class ThreadPool {
+public:
+	// threads <= 0 starts one worker per core
+	explicit ThreadPool(int threads = 0);
+	// waits for every task, then stops the workers
+	~ThreadPool();
+
+	// queues task on the next worker's queue, round robin
+	void submit(const std::function<void()> &task);
+	// blocks until every submitted task has run
+	void wait();
+	int size() const { return (int)workers.size(); }
+
+private:
+	struct Queue {
+		std::mutex lock;
+		std::deque<std::function<void()> > tasks;
+	};
+
+	std::vector<std::thread> workers;
+	std::vector<Queue*> queues;
+	unsigned nextQueue;
+
+	// guards pending and stopping, and is what idle workers and wait() sleep on
+	std::mutex stateLock;
+	std::condition_variable wake, idle;
+	int pending; // tasks submitted and not yet finished
+	bool stopping;
+
+	bool popTask(int self, std::function<void()> &task);
+	void run(int self);
+};
+
+#endif // __THREADPOOL_H__
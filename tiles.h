@@ -0,0 +1,82 @@
+#ifndef __TILES_H__
+#define __TILES_H__
+
+#include "cell.h"
+#include "bitboard.h"
+
+#define MAX_TILE_ORIENTATIONS 4
+// no cell of a tile is further than this many rows or columns from its center, however it is turned
+#define TILE_REACH 2
+
+//-------------------------------------------------------------------------------------------------------------------
+// TileShape enum of list of valid shapes
+enum TileShape {
+	TileShapeI,
+	TileShapeS,
+	TileShapeZ,
+	TileShapeO,
+	TileShapeT,
+	TileShapeJ,
+	TileShapeL,
+	MaxTileShapes
+};
+
+// offsets of the 4 cells of each shape from its center cell, as a new tile spawns before it is turned
+constexpr Cell allShapes[MaxTileShapes][4] =
+	{{Cell(-2,  0), Cell(-1,  0), Cell(0, 0), Cell( 1,  0)},  // I
+	 {Cell(-1, -1), Cell( 0, -1), Cell(0, 0), Cell( 1,  0)},  // S
+	 {Cell( 1, -1), Cell( 0, -1), Cell(0, 0), Cell(-1,  0)},  // Z
+	 {Cell(-1, -1), Cell( 0, -1), Cell(0, 0), Cell(-1,  0)},  // O
+	 {Cell(-1,  0), Cell( 1,  0), Cell(0, 0), Cell( 0,  1)},  // T
+	 {Cell(-1,  1), Cell(-1,  0), Cell(0, 0), Cell( 1,  0)},  // J
+	 {Cell(-1, -1), Cell(-1,  0), Cell(0, 0), Cell( 1,  0)}}; // L
+
+//-------------------------------------------------------------------------------------------------------------------
+// A shape turned some quarter turns clockwise, with the row masks to test it against the board
+struct TileOrientation {
+	Cell offsets[4];
+	TileFootprint footprint;
+};
+
+struct TileOrientations {
+	TileOrientation o[MaxTileShapes][MAX_TILE_ORIENTATIONS];
+};
+
+constexpr TileOrientations makeTileOrientations() {
+	TileOrientations t{};
+	for(int s = 0; s < MaxTileShapes; s++) {
+		for(int r = 0; r < MAX_TILE_ORIENTATIONS; r++) {
+			for(int i = 0; i < 4; i++) {
+				Cell c = allShapes[s][i];
+				// the O piece is the same every way up, turning it shuffles its colours instead
+				for(int k = 0; s != TileShapeO && k < r; k++) c = c.rotated();
+				t.o[s][r].offsets[i] = c;
+			}
+			t.o[s][r].footprint.set(t.o[s][r].offsets);
+		}
+	}
+	return t;
+}
+
+// tileOrientations.o[shape][r] is the shape turned r quarter turns clockwise
+constexpr TileOrientations tileOrientations = makeTileOrientations();
+
+constexpr bool withinTileReach(const TileOrientations &t) {
+	for(int s = 0; s < MaxTileShapes; s++)
+		for(int r = 0; r < MAX_TILE_ORIENTATIONS; r++)
+			for(int i = 0; i < 4; i++) {
+				Cell c = t.o[s][r].offsets[i];
+				if(c.x < -TILE_REACH || c.x > TILE_REACH || c.y < -TILE_REACH || c.y > TILE_REACH) return false;
+			}
+	return true;
+}
+
+static_assert(withinTileReach(tileOrientations), "every cell of a tile is within TILE_REACH of its center");
+static_assert(tileOrientations.o[TileShapeI][1].footprint.rows[3] == 1 && tileOrientations.o[TileShapeI][1].footprint.minY == -1,
+			  "the I piece stands upright after one turn");
+static_assert(tileOrientations.o[TileShapeO][2].footprint.rows[0] == 3 && tileOrientations.o[TileShapeO][2].footprint.rows[1] == 3,
+			  "the O piece doesn't turn");
+static_assert(tileOrientations.o[TileShapeT][2].footprint.bottom[1] == -1 && tileOrientations.o[TileShapeT][2].footprint.bottom[0] == 0,
+			  "the T piece points down after two turns");
+
+#endif // __TILES_H__
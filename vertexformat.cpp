@@ -0,0 +1,75 @@
+#include <vector>
+#include <algorithm>
+#include "vertexformat.h"
+
+using namespace std;
+
+VertexLayout vertexLayout = VertexPacked;
+
+// padded to 8 bytes so every vertex stays 4 byte aligned
+struct PackedPosition {
+	GLshort x, y, z, pad;
+};
+
+const char *vertexShader() {
+	return vertexLayout == VertexPacked ? "vshader_packed.glsl" : "vshader.glsl";
+}
+
+GLsizei positionSize() {
+	return vertexLayout == VertexPacked ? sizeof(PackedPosition) : sizeof(vec4);
+}
+
+GLsizei colourSize() {
+	return vertexLayout == VertexPacked ? 4*sizeof(GLubyte) : sizeof(vec4);
+}
+
+void packColour(const vec4 &c, GLubyte *out) {
+	for(int k = 0; k < 4; k++)
+		out[k] = (GLubyte)(max(0.0f, min(1.0f, c[k]))*255 + 0.5f);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+void bufferPositions(int first, int n, const vec4 *p, GLfloat unit) {
+	if(vertexLayout == VertexFloat) {
+		glBufferSubData(GL_ARRAY_BUFFER, first*sizeof(vec4), n*sizeof(vec4), p);
+		return;
+	}
+	vector<PackedPosition> packed(n);
+	for(int i = 0; i < n; i++) {
+		// round to nearest, the positions are meant to be whole multiples of unit
+		packed[i].x = (GLshort)floor(p[i].x/unit + 0.5);
+		packed[i].y = (GLshort)floor(p[i].y/unit + 0.5);
+		packed[i].z = (GLshort)floor(p[i].z/unit + 0.5);
+		packed[i].pad = 0;
+	}
+	glBufferSubData(GL_ARRAY_BUFFER, first*sizeof(PackedPosition), n*sizeof(PackedPosition), &packed[0]);
+}
+
+void bufferColours(int first, int n, const vec4 *c) {
+	if(vertexLayout == VertexFloat) {
+		glBufferSubData(GL_ARRAY_BUFFER, first*sizeof(vec4), n*sizeof(vec4), c);
+		return;
+	}
+	vector<GLubyte> packed(4*n);
+	for(int i = 0; i < n; i++) packColour(c[i], &packed[4*i]);
+	glBufferSubData(GL_ARRAY_BUFFER, 4*first, 4*n, &packed[0]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+
+void positionPointer(GLuint attr, GLintptr offset) {
+	if(vertexLayout == VertexPacked)
+		glVertexAttribPointer(attr, 3, GL_SHORT, GL_FALSE, sizeof(PackedPosition), BUFFER_OFFSET(offset));
+	else
+		glVertexAttribPointer(attr, 4, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(offset));
+	glEnableVertexAttribArray(attr);
+}
+
+void colourPointer(GLuint attr, GLintptr offset) {
+	if(vertexLayout == VertexPacked)
+		glVertexAttribPointer(attr, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, BUFFER_OFFSET(offset));
+	else
+		glVertexAttribPointer(attr, 4, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(offset));
+	glEnableVertexAttribArray(attr);
+}
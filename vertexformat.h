@@ -0,0 +1,35 @@
+#ifndef __VERTEXFORMAT_H__
+#define __VERTEXFORMAT_H__
+
+#include "include/Angel.h"
+
+// Vertex layouts the (non instanced) shaders can be fed with, picked once before init:
+//   VertexFloat  - vec4 positions and colours, 32 bytes a vertex, drawn by vshader.glsl
+//   VertexPacked - positions as 3 GLshorts counted in multiples of a unit, colours as normalized RGBA8,
+//                  12 bytes a vertex, drawn by vshader_packed.glsl
+enum VertexLayout {
+	VertexFloat,
+	VertexPacked
+};
+extern VertexLayout vertexLayout;
+
+// vertex shader matching vertexLayout
+const char *vertexShader();
+
+// bytes one position or colour takes in the bound VBO
+GLsizei positionSize();
+GLsizei colourSize();
+
+// Replaces n positions (or colours) of the bound VBO starting at vertex first; when packed, positions are
+// divided by unit, which has to be set as the shader's positionUnit when they are drawn
+void bufferPositions(int first, int n, const vec4 *p, GLfloat unit);
+void bufferColours(int first, int n, const vec4 *c);
+
+// Points attribute attr at the positions (or colours) of the bound VBO starting at byte offset
+void positionPointer(GLuint attr, GLintptr offset);
+void colourPointer(GLuint attr, GLintptr offset);
+
+// c as RGBA8, clamped to [0, 1]
+void packColour(const vec4 &c, GLubyte *out);
+
+#endif // __VERTEXFORMAT_H__
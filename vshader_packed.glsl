@@ -0,0 +1,16 @@
+#version 130
+
+// positions are whole multiples of positionUnit, colours normalized bytes
+in vec3 vPosition;
+in vec4 vColor;
+out vec4 color;
+
+uniform mat4 MVP;
+uniform float positionUnit;
+
+void main() 
+{
+	gl_Position = MVP * vec4(positionUnit*vPosition, 1.0);
+
+	color = vColor;	
+} 